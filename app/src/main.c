@@ -7,16 +7,54 @@
 #include <zephyr/kernel.h>
 #include <zephyr/zbus/zbus.h>
 
+#include "mdm_health.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(main, LOG_LEVEL_DBG);
 
+#if defined(CONFIG_MDM_HEALTH)
+/* Publish a health report and log its summary */
+static void supervise(void)
+{
+	struct mdm_health_msg msg;
+	int err;
+
+	err = mdm_health_publish(&msg);
+	if (err) {
+		LOG_WRN("Cannot publish health report, error: %d", err);
+		return;
+	}
+
+	LOG_DBG("CPU %u.%u%%, heap %u/%u bytes (max %u), modules ready 0x%02x, failed 0x%02x",
+		msg.cpu_load / 10, msg.cpu_load % 10, msg.heap_used, msg.heap_size,
+		msg.heap_max_used, msg.modules_ready, msg.modules_failed);
+
+	for (size_t i = 0; i < msg.thread_count; i++) {
+		const struct mdm_health_thread *thread = &msg.threads[i];
+
+		LOG_DBG("  %-*.*s %3u.%u%%, stack %u/%u bytes", MDM_HEALTH_THREAD_NAME_LEN,
+			MDM_HEALTH_THREAD_NAME_LEN, thread->name, thread->load / 10,
+			thread->load % 10, thread->stack_size - thread->stack_unused,
+			thread->stack_size);
+	}
+}
+#endif /* CONFIG_MDM_HEALTH */
 
 int main(void)
 {
 	LOG_INF("Module runner started");
+
+#if defined(CONFIG_MDM_HEALTH)
+	while (1) {
+		k_sleep(K_MSEC(CONFIG_MDM_HEALTH_INTERVAL_MS));
+		supervise();
+	}
+#else
 	while (1) {
 		k_sleep(K_SECONDS(10));
 		LOG_INF("Module runner alive");
 	}
+#endif /* CONFIG_MDM_HEALTH */
+
 	return 0;
 }
@@ -17,6 +17,8 @@
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/gatt.h>
 #include <zephyr/bluetooth/hci.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/atomic.h>
 
 #include <bluetooth/services/nus.h>
 
@@ -25,6 +27,12 @@
 
 #include <zephyr/settings/settings.h>
 
+#include "mdm_link.h"
+#include "mdm_channels.h"
+#include "mdm_zbus_log.h"
+#include "mdm_health.h"
+#include "mdm_stats.h"
+
 #ifdef CONFIG_BLE_NUS_MODULE_DK_SUPPORT
 #include <dk_buttons_and_leds.h>
 #endif
@@ -40,23 +48,36 @@ LOG_MODULE_REGISTER(ble_nus_module, CONFIG_MDM_BLE_NUS_LOG_LEVEL);
 /* This file is for the runner side: the controller has the shadow channel, and the
  * runner has the main channel
  */
-ZBUS_CHAN_DEFINE(
-	BLE_NUS_CHAN,
-	struct ble_nus_module_message,
-	NULL,
-	NULL,
-	ZBUS_OBSERVERS_EMPTY,
-	ZBUS_MSG_INIT(0)
-);
-
-ZBUS_PROXY_ADD_CHAN(MDM_BLE_NUS_PROXY_NODE, BLE_NUS_CHAN);
-
-#define BLE_TX_BUFFER_SIZE     64
-#define BLE_TX_TIMEOUT_MS      1000
+MDM_CHANNELS_DEFINE(MDM_BLE_NUS_CHANNELS, RUNNER)
+
+#define BLE_TX_RETRY_MS        10
 #define BLE_ATT_PRIME_DELAY_MS 200
 
+/* Longest time the BT RX thread waits for BLE_NUS_CHAN and its observers, a phone write is
+ * dropped after that instead of stalling the reception of the other connections
+ */
+#define BLE_RX_PUB_TIMEOUT K_MSEC(10)
+
+/* Largest notification the host can send, the ATT MTU minus the opcode and handle */
+#define BLE_TX_DATA_SIZE (CONFIG_BT_L2CAP_TX_MTU - 3)
+
+/* Notifications of a connection handed to the host without their sent callback yet, one ACL
+ * buffer each. The buffers are shared by the connections, so that a busy phone cannot hold all of
+ * them.
+ */
+#define BLE_TX_IN_FLIGHT MAX(CONFIG_BT_BUF_ACL_TX_COUNT / CONFIG_BLE_NUS_MAX_CONN, 1)
+
+BUILD_ASSERT(CONFIG_BLE_NUS_MAX_CONN <= CONFIG_BT_MAX_CONN, "BT_MAX_CONN below BLE_NUS_MAX_CONN");
+BUILD_ASSERT(CONFIG_BLE_NUS_MAX_CONN < BLE_NUS_CONN_ID_ALL);
+
+#if defined(CONFIG_BLE_NUS_PROFILE_THROUGHPUT)
+/* 15-30 ms, the controller extends each connection event for as long as there is data */
+#define BLE_NUS_CONN_INTERVAL_MIN 12
+#define BLE_NUS_CONN_INTERVAL_MAX 24
+#else
 #define BLE_NUS_CONN_INTERVAL_MIN BT_GAP_ADV_FAST_INT_MIN_2 / 2
 #define BLE_NUS_CONN_INTERVAL_MAX BT_GAP_ADV_FAST_INT_MAX_2 / 2
+#endif
 
 /* Internal callback types */
 typedef void (*ble_data_received_cb_t)(struct bt_conn *conn, const uint8_t *data, uint16_t len);
@@ -70,17 +91,52 @@ struct ble_nus_module_config {
 	ble_ready_cb_t ready_cb;
 };
 
+/* A connection with a phone, its index in nus_conns is the connection id */
+struct nus_conn {
+	/* NULL when the slot is free. Changed in the BT RX thread with nus_tx_mutex held */
+	struct bt_conn *conn;
+
+	/* The phone enabled notifications and the ATT channel was primed */
+	bool ready;
+
+	/* TX queue, one notification per buffer */
+	struct k_fifo tx_queue;
+	atomic_t tx_in_flight;
+
+	/* Buffer the host had no room for. Protected by nus_tx_mutex */
+	struct net_buf *tx_head;
+
+	/* Notification still open for batching, not queued yet. Protected by nus_tx_mutex */
+	struct net_buf *tx_tail;
+	struct k_work_delayable batch_work;
+
+	/* Data from BLE_NUS_TX_CHAN was refused, publish BLE_NUS_TX_READY once the queue empties */
+	atomic_t tx_busy;
+
+#if defined(CONFIG_BLE_NUS_PROFILE_THROUGHPUT)
+	/* Used by the host until the exchange completes */
+	struct bt_gatt_exchange_params mtu_exchange;
+#endif
+};
+
 /* Module states */
-static struct bt_conn *current_conn;
+static struct nus_conn nus_conns[CONFIG_BLE_NUS_MAX_CONN];
 static struct bt_conn *auth_conn;
 static struct k_work adv_work;
-static K_SEM_DEFINE(nus_tx_sem, 1, 1);
+static struct k_work_delayable ready_work;
 static bool module_enabled;
-static bool nus_notifications_enabled;
 static ble_data_received_cb_t user_data_cb;
 static ble_connection_status_cb_t user_connection_status_cb;
 static ble_ready_cb_t user_ready_cb;
 
+/* NUS TX characteristic, to find the phones that enabled notifications */
+static const struct bt_gatt_attr *nus_tx_attr;
+
+/* TX buffers, shared by the connections. The mutex is never held while waiting */
+NET_BUF_POOL_FIXED_DEFINE(nus_tx_pool, CONFIG_BLE_NUS_TX_BUF_COUNT, BLE_TX_DATA_SIZE, 0, NULL);
+static K_MUTEX_DEFINE(nus_tx_mutex);
+static struct k_work_delayable send_work;
+
 /* Advertising data */
 #define DEVICE_NAME     CONFIG_BT_DEVICE_NAME
 #define DEVICE_NAME_LEN (sizeof(DEVICE_NAME) - 1)
@@ -94,29 +150,158 @@ static const struct bt_data sd[] = {
 	BT_DATA_BYTES(BT_DATA_UUID128_ALL, BT_UUID_NUS_VAL),
 };
 
-static int publish_ble_data(const uint8_t *data, uint16_t len)
+/* Slot of a connection, or a free slot for NULL */
+static struct nus_conn *nus_conn_get(const struct bt_conn *conn)
 {
-	int ret;
+	for (size_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+		if (nus_conns[i].conn == conn) {
+			return &nus_conns[i];
+		}
+	}
+
+	return NULL;
+}
+
+static uint8_t nus_conn_id(const struct nus_conn *slot)
+{
+	return (uint8_t)(slot - nus_conns);
+}
+
+static size_t nus_conn_count(void)
+{
+	size_t count = 0;
 
-	struct ble_nus_module_message msg = {0};
+	for (size_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+		if (nus_conns[i].conn) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/* Reference to the connection of a slot, for threads other than the BT RX thread */
+static struct bt_conn *nus_conn_ref(struct nus_conn *slot)
+{
+	struct bt_conn *conn;
+
+	k_mutex_lock(&nus_tx_mutex, K_FOREVER);
+	conn = slot->conn ? bt_conn_ref(slot->conn) : NULL;
+	k_mutex_unlock(&nus_tx_mutex);
 
-	msg.type = BLE_RECV;
-	msg.len = len;
-	memcpy(msg.data, data, len);
-	msg.timestamp = k_uptime_get_32();
+	return conn;
+}
 
-	ret = zbus_chan_pub(&BLE_NUS_CHAN, &msg, K_FOREVER);
+/* Publish a write of a phone, in chunks of at most BLE_NUS_MODULE_MESSAGE_SIZE bytes */
+static int publish_ble_data(uint8_t conn_id, const uint8_t *data, uint16_t len)
+{
+	static uint16_t seq;
+	uint32_t timestamp = k_uptime_get_32();
+	uint16_t offset = 0;
+	int ret;
+
+	/* Drop the data instead of stalling the BT RX thread when the other domain lags behind.
+	 * All chunks need a credit, a chunk waiting for one would be replaced by the next.
+	 */
+	ret = mdm_link_tx_ready_count(&BLE_NUS_CHAN,
+				      MAX(DIV_ROUND_UP(len, BLE_NUS_MODULE_MESSAGE_SIZE), 1));
 	if (ret != 0) {
-		LOG_ERR("Failed to publish BLE data: %d", ret);
+		LOG_WRN("Dropping %u byte BLE message, link not ready: %d", len, ret);
+		return ret;
 	}
-	return ret;
+
+	seq++;
+
+	/* An empty write is published as one empty chunk */
+	do {
+		struct ble_nus_module_message *msg;
+		uint16_t chunk = MIN(len - offset, BLE_NUS_MODULE_MESSAGE_SIZE);
+
+		/* Fill the channel message in place instead of publishing a copy built on the
+		 * stack
+		 */
+		ret = zbus_chan_claim(&BLE_NUS_CHAN, BLE_RX_PUB_TIMEOUT);
+		if (ret != 0) {
+			LOG_WRN("Dropping %u byte BLE message, channel busy: %d", len, ret);
+			mdm_stats_pub_failed(&BLE_NUS_CHAN, ret);
+			return ret;
+		}
+
+		msg = zbus_chan_msg(&BLE_NUS_CHAN);
+		msg->type = BLE_RECV;
+		msg->len = chunk;
+		memcpy(msg->data, &data[offset], chunk);
+		msg->timestamp = timestamp;
+		msg->seq = seq;
+		msg->offset = offset;
+		msg->total_len = len;
+		msg->conn_id = conn_id;
+
+		(void)zbus_chan_finish(&BLE_NUS_CHAN);
+
+		/* A write cut short is discarded by the reassembly on the other domain */
+		ret = zbus_chan_notify(&BLE_NUS_CHAN, BLE_RX_PUB_TIMEOUT);
+		if (ret != 0) {
+			LOG_WRN("Dropping %u byte BLE message, publish failed: %d", len, ret);
+			mdm_stats_pub_failed(&BLE_NUS_CHAN, ret);
+			return ret;
+		}
+
+		offset += chunk;
+	} while (offset < len);
+
+	return 0;
 }
 
 /* BLE callbacks */
+#if defined(CONFIG_BLE_NUS_PROFILE_THROUGHPUT)
+static void mtu_exchange_cb(struct bt_conn *conn, uint8_t err,
+			    struct bt_gatt_exchange_params *params)
+{
+	if (err) {
+		LOG_WRN("MTU exchange failed (err %u)", err);
+	}
+}
+
+/* Request the largest ATT MTU and data length and the 2M PHY, the phone may refuse any of them */
+static void throughput_request(struct nus_conn *slot)
+{
+	struct bt_conn *conn = slot->conn;
+	const struct bt_conn_le_data_len_param data_len = {
+		.tx_max_len = BT_GAP_DATA_LEN_MAX,
+		.tx_max_time = BT_GAP_DATA_TIME_MAX,
+	};
+	const struct bt_conn_le_phy_param phy = {
+		.options = BT_CONN_LE_PHY_OPT_NONE,
+		.pref_tx_phy = BT_GAP_LE_PHY_2M,
+		.pref_rx_phy = BT_GAP_LE_PHY_2M,
+	};
+	int err;
+
+	slot->mtu_exchange.func = mtu_exchange_cb;
+
+	err = bt_gatt_exchange_mtu(conn, &slot->mtu_exchange);
+	if (err) {
+		LOG_WRN("Failed to request MTU exchange (err %d)", err);
+	}
+
+	err = bt_conn_le_data_len_update(conn, &data_len);
+	if (err) {
+		LOG_WRN("Failed to request data length update (err %d)", err);
+	}
+
+	err = bt_conn_le_phy_update(conn, &phy);
+	if (err) {
+		LOG_WRN("Failed to request PHY update (err %d)", err);
+	}
+}
+#endif /* CONFIG_BLE_NUS_PROFILE_THROUGHPUT */
+
 static void connected(struct bt_conn *conn, uint8_t err)
 {
 	char addr[BT_ADDR_LE_STR_LEN];
 	struct bt_conn_info info;
+	struct nus_conn *slot;
 
 	if (err) {
 		LOG_ERR("Connection failed, err 0x%02x %s", err, bt_hci_err_to_str(err));
@@ -130,12 +315,33 @@ static void connected(struct bt_conn *conn, uint8_t err)
 	}
 
 	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
-	LOG_INF("BLE NUS Connected to %s", addr);
+
+	slot = nus_conn_get(NULL);
+	if (!slot) {
+		/* Only with connections that were not made by advertising for NUS */
+		LOG_WRN("All %u NUS connections in use, disconnecting %s", CONFIG_BLE_NUS_MAX_CONN,
+			addr);
+		(void)bt_conn_disconnect(conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+		return;
+	}
+
+	LOG_INF("BLE NUS Connected to %s, connection %u", addr, nus_conn_id(slot));
 	LOG_INF("Negotiated connection parameters: interval %u (%.1fms), latency %u, timeout %u",
 		info.le.interval, (double)(info.le.interval * 1.25), info.le.latency,
 		info.le.timeout);
 
-	current_conn = bt_conn_ref(conn);
+	k_mutex_lock(&nus_tx_mutex, K_FOREVER);
+	slot->conn = bt_conn_ref(conn);
+	slot->ready = false;
+	k_mutex_unlock(&nus_tx_mutex);
+
+	/* Advertising stopped with the connection, keep accepting phones while slots are free */
+	if (module_enabled && nus_conn_get(NULL)) {
+		k_work_submit(&adv_work);
+	}
+
+	/* Polls until the phone enables notifications */
+	k_work_schedule(&ready_work, K_MSEC(BLE_ATT_PRIME_DELAY_MS));
 
 	struct bt_le_conn_param param = {
 		.interval_min = BLE_NUS_CONN_INTERVAL_MIN,
@@ -153,6 +359,10 @@ static void connected(struct bt_conn *conn, uint8_t err)
 			(double)(param.interval_max * 1.25));
 	}
 
+#if defined(CONFIG_BLE_NUS_PROFILE_THROUGHPUT)
+	throughput_request(slot);
+#endif
+
 	if (user_connection_status_cb) {
 		user_connection_status_cb(conn, true);
 	}
@@ -165,7 +375,7 @@ static void connected(struct bt_conn *conn, uint8_t err)
 static void le_param_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
 			     uint16_t timeout)
 {
-	if (conn != current_conn) {
+	if (!nus_conn_get(conn)) {
 		return;
 	}
 
@@ -173,39 +383,106 @@ static void le_param_updated(struct bt_conn *conn, uint16_t interval, uint16_t l
 		interval, (double)(interval * 1.25), latency, timeout);
 }
 
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+static void le_data_len_updated(struct bt_conn *conn, struct bt_conn_le_data_len_info *info)
+{
+	if (!nus_conn_get(conn)) {
+		return;
+	}
+
+	LOG_INF("Data length updated: TX %u bytes (%u us), RX %u bytes (%u us)",
+		info->tx_max_len, info->tx_max_time, info->rx_max_len, info->rx_max_time);
+}
+#endif
+
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+static void le_phy_updated(struct bt_conn *conn, struct bt_conn_le_phy_info *info)
+{
+	if (!nus_conn_get(conn)) {
+		return;
+	}
+
+	LOG_INF("PHY updated: TX %u, RX %u", info->tx_phy, info->rx_phy);
+}
+#endif
+
+static void att_mtu_updated(struct bt_conn *conn, uint16_t tx, uint16_t rx)
+{
+	if (!nus_conn_get(conn)) {
+		return;
+	}
+
+	LOG_INF("ATT MTU updated: TX %u, RX %u", tx, rx);
+}
+
+static struct bt_gatt_cb gatt_callbacks = {
+	.att_mtu_updated = att_mtu_updated,
+};
+
+/* Drop the data queued for a connection, with nus_tx_mutex held */
+static void tx_drop(struct nus_conn *slot)
+{
+	struct net_buf *buf;
+
+	while ((buf = k_fifo_get(&slot->tx_queue, K_NO_WAIT)) != NULL) {
+		net_buf_unref(buf);
+	}
+
+	if (slot->tx_head) {
+		net_buf_unref(slot->tx_head);
+		slot->tx_head = NULL;
+	}
+
+	if (slot->tx_tail) {
+		net_buf_unref(slot->tx_tail);
+		slot->tx_tail = NULL;
+	}
+
+	atomic_set(&slot->tx_in_flight, 0);
+	atomic_set(&slot->tx_busy, 0);
+}
+
 static void disconnected(struct bt_conn *conn, uint8_t reason)
 {
 	char addr[BT_ADDR_LE_STR_LEN];
+	struct nus_conn *slot = nus_conn_get(conn);
 
-	if (conn != current_conn) {
+	if (!slot) {
 		LOG_DBG("Ignoring disconnect for non-NUS connection");
 		return;
 	}
 
 	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
-	LOG_DBG("Disconnected: %s, reason 0x%02x %s", addr, reason, bt_hci_err_to_str(reason));
+	LOG_DBG("Disconnected: %s, connection %u, reason 0x%02x %s", addr, nus_conn_id(slot),
+		reason, bt_hci_err_to_str(reason));
 
-	if (auth_conn) {
+	if (auth_conn == conn) {
 		bt_conn_unref(auth_conn);
 		auth_conn = NULL;
 	}
 
-	if (current_conn) {
-		if (user_connection_status_cb) {
-			user_connection_status_cb(conn, false);
-		}
+	if (user_connection_status_cb) {
+		user_connection_status_cb(conn, false);
+	}
 
-		if (user_ready_cb) {
-			user_ready_cb(conn, false);
-		}
+	if (user_ready_cb) {
+		user_ready_cb(conn, false);
+	}
+
+	/* The slot is free for the next phone once its data is dropped */
+	k_mutex_lock(&nus_tx_mutex, K_FOREVER);
+	tx_drop(slot);
+	slot->ready = false;
+	slot->conn = NULL;
+	k_mutex_unlock(&nus_tx_mutex);
+
+	bt_conn_unref(conn);
 
-		bt_conn_unref(current_conn);
-		current_conn = NULL;
-		nus_notifications_enabled = false;
 #ifdef CONFIG_BLE_NUS_MODULE_DK_SUPPORT
+	if (nus_conn_count() == 0) {
 		dk_set_led_off(DK_LED1);
-#endif
 	}
+#endif
 }
 
 static void recycled_cb(void)
@@ -236,6 +513,12 @@ BT_CONN_CB_DEFINE(conn_callbacks) = {
 	.connected = connected,
 	.disconnected = disconnected,
 	.le_param_updated = le_param_updated,
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+	.le_data_len_updated = le_data_len_updated,
+#endif
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+	.le_phy_updated = le_phy_updated,
+#endif
 	.recycled = recycled_cb,
 #ifdef CONFIG_BT_NUS_SECURITY_ENABLED
 	.security_changed = security_changed,
@@ -302,43 +585,211 @@ static struct bt_conn_auth_info_cb conn_auth_info_callbacks = {.pairing_complete
 
 static void bt_receive_cb(struct bt_conn *conn, const uint8_t *const data, uint16_t len)
 {
-	publish_ble_data(data, len);
+	struct nus_conn *slot = nus_conn_get(conn);
+
+	if (!slot) {
+		return;
+	}
+
+	publish_ble_data(nus_conn_id(slot), data, len);
 
 	if (user_data_cb) {
 		user_data_cb(conn, data, len);
 	}
 }
 
-static struct k_work_delayable ready_work;
-
+/* Prime the ATT channel of the phones that enabled notifications */
 static void ready_work_handler(struct k_work *work)
 {
 	const char *msg = "\r\n";
-	int ret = bt_nus_send(NULL, (const uint8_t *)msg, strlen(msg));
+	bool pending = false;
+
+	for (size_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+		struct nus_conn *slot = &nus_conns[i];
+		struct bt_conn *conn;
+
+		if (slot->ready) {
+			continue;
+		}
+
+		conn = nus_conn_ref(slot);
+		if (!conn) {
+			continue;
+		}
 
-	if (ret == 0) {
-		LOG_DBG("ATT channel primed and ready");
+		if (bt_gatt_is_subscribed(conn, nus_tx_attr, BT_GATT_CCC_NOTIFY) &&
+		    bt_nus_send(conn, (const uint8_t *)msg, strlen(msg)) == 0) {
+			LOG_DBG("ATT channel of connection %u primed and ready", i);
+			slot->ready = true;
 
-		if (user_ready_cb && current_conn) {
-			user_ready_cb(current_conn, true);
+			if (user_ready_cb) {
+				user_ready_cb(conn, true);
+			}
+		} else {
+			pending = true;
 		}
+
+		bt_conn_unref(conn);
+	}
+
+	/* The NUS service only reports the first phone enabling notifications and the last one
+	 * disabling them, the others are polled
+	 */
+	if (pending) {
+		k_work_schedule(&ready_work, K_MSEC(BLE_ATT_PRIME_DELAY_MS));
 	}
 }
 
 static void nus_send_enabled_cb(enum bt_nus_send_status status)
 {
-	nus_notifications_enabled = (status == BT_NUS_SEND_STATUS_ENABLED);
-	LOG_DBG("NUS notifications %s", nus_notifications_enabled ? "enabled" : "disabled");
+	bool enabled = (status == BT_NUS_SEND_STATUS_ENABLED);
 
-	if (nus_notifications_enabled) {
-		k_work_schedule(&ready_work, K_MSEC(BLE_ATT_PRIME_DELAY_MS));
+	LOG_DBG("NUS notifications %s", enabled ? "enabled" : "disabled");
+
+	/* None of the phones wants notifications anymore */
+	if (!enabled) {
+		for (size_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+			nus_conns[i].ready = false;
+		}
+	}
+
+	k_work_reschedule(&ready_work, K_MSEC(BLE_ATT_PRIME_DELAY_MS));
+}
+
+static void tx_status_publish(const struct ble_nus_tx_status *status)
+{
+	int err;
+
+	err = zbus_chan_pub(&BLE_NUS_TX_STATUS_CHAN, status, K_NO_WAIT);
+	if (err) {
+		LOG_WRN("Failed to publish TX status: %d", err);
+		mdm_stats_pub_failed(&BLE_NUS_TX_STATUS_CHAN, err);
+	}
+}
+
+/* Hand the next notification of a connection to the host.
+ *
+ * Returns 0 when a notification was taken from the queue, -ENODATA when there is nothing to send
+ * or the connection has all its notifications in flight, and -ENOMEM when the host is out of
+ * buffers.
+ */
+static int tx_next(struct nus_conn *slot)
+{
+	struct bt_conn *conn;
+	struct net_buf *buf;
+	int err;
+
+	k_mutex_lock(&nus_tx_mutex, K_FOREVER);
+
+	if (!slot->conn || atomic_get(&slot->tx_in_flight) >= BLE_TX_IN_FLIGHT) {
+		k_mutex_unlock(&nus_tx_mutex);
+		return -ENODATA;
+	}
+
+	buf = slot->tx_head ? slot->tx_head : k_fifo_get(&slot->tx_queue, K_NO_WAIT);
+	slot->tx_head = NULL;
+
+	if (!buf) {
+		k_mutex_unlock(&nus_tx_mutex);
+
+		if (atomic_cas(&slot->tx_busy, 1, 0)) {
+			tx_status_publish(&(struct ble_nus_tx_status){
+				.result = BLE_NUS_TX_READY,
+				.conn_id = nus_conn_id(slot),
+			});
+		}
+
+		return -ENODATA;
 	}
+
+	conn = bt_conn_ref(slot->conn);
+	k_mutex_unlock(&nus_tx_mutex);
+
+	(void)atomic_inc(&slot->tx_in_flight);
+
+	err = bt_nus_send(conn, buf->data, buf->len);
+	if (err) {
+		(void)atomic_dec(&slot->tx_in_flight);
+	}
+
+	if (err == -ENOMEM) {
+		/* Out of host buffers, retried once some were released. Dropped if the phone
+		 * disconnected in the meantime
+		 */
+		k_mutex_lock(&nus_tx_mutex, K_FOREVER);
+		if (slot->conn == conn) {
+			slot->tx_head = buf;
+			buf = NULL;
+		}
+		k_mutex_unlock(&nus_tx_mutex);
+	} else if (err == -EINVAL) {
+		/* The phone disabled notifications, its queue is dropped until they are enabled and
+		 * the channel is primed again
+		 */
+		if (slot->ready) {
+			LOG_WRN("Connection %u disabled notifications", nus_conn_id(slot));
+			slot->ready = false;
+			k_work_schedule(&ready_work, K_MSEC(BLE_ATT_PRIME_DELAY_MS));
+		}
+	} else if (err) {
+		LOG_ERR("Failed to send %u bytes on connection %u: %d", buf->len, nus_conn_id(slot),
+			err);
+	}
+
+	/* The host copied the data */
+	if (buf) {
+		net_buf_unref(buf);
+	}
+
+	bt_conn_unref(conn);
+
+	return (err == -ENOMEM) ? err : 0;
+}
+
+/* One notification of each connection in turn, so that a phone with a long queue does not hold
+ * back the others
+ */
+static void send_work_handler(struct k_work *work)
+{
+	bool taken;
+
+	do {
+		taken = false;
+
+		for (size_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+			int err = tx_next(&nus_conns[i]);
+
+			if (err == -ENOMEM) {
+				k_work_reschedule(&send_work, K_MSEC(BLE_TX_RETRY_MS));
+				return;
+			}
+
+			taken |= (err == 0);
+		}
+	} while (taken);
+
+	/* Resubmitted by the sent callback */
 }
 
 static void nus_sent_cb(struct bt_conn *conn)
 {
-	LOG_DBG("Data sent successfully - releasing semaphore");
-	k_sem_give(&nus_tx_sem);
+	struct nus_conn *slot = nus_conn_get(conn);
+	atomic_val_t in_flight;
+
+	if (!slot) {
+		return;
+	}
+
+	in_flight = atomic_get(&slot->tx_in_flight);
+
+	/* Not counted when the in-flight notifications were dropped on disconnection, or for the
+	 * priming notification
+	 */
+	while (in_flight > 0 && !atomic_cas(&slot->tx_in_flight, in_flight, in_flight - 1)) {
+		in_flight = atomic_get(&slot->tx_in_flight);
+	}
+
+	k_work_reschedule(&send_work, K_NO_WAIT);
 }
 
 static struct bt_nus_cb nus_cb = {
@@ -349,7 +800,14 @@ static struct bt_nus_cb nus_cb = {
 
 static void adv_work_handler(struct k_work *work)
 {
-	int err = bt_le_adv_start(BT_LE_ADV_CONN_FAST_2, ad, ARRAY_SIZE(ad), sd, ARRAY_SIZE(sd));
+	int err;
+
+	if (!nus_conn_get(NULL)) {
+		LOG_DBG("All %u NUS connections in use, not advertising", CONFIG_BLE_NUS_MAX_CONN);
+		return;
+	}
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN_FAST_2, ad, ARRAY_SIZE(ad), sd, ARRAY_SIZE(sd));
 	if (err == -EALREADY) {
 		LOG_DBG("Advertising already active");
 	} else if (err) {
@@ -408,6 +866,14 @@ static int ble_nus_module_init(const struct ble_nus_module_config *config)
 		return err;
 	}
 
+	nus_tx_attr = bt_gatt_find_by_uuid(NULL, 0, BT_UUID_NUS_TX);
+	if (!nus_tx_attr) {
+		LOG_ERR("NUS TX characteristic not found");
+		return -ENOENT;
+	}
+
+	bt_gatt_cb_register(&gatt_callbacks);
+
 	k_work_init(&adv_work, adv_work_handler);
 	k_work_init_delayable(&ready_work, ready_work_handler);
 
@@ -429,94 +895,239 @@ static int ble_nus_module_enable(void)
 	return 0;
 }
 
-int ble_nus_module_send(const uint8_t *data, uint16_t len)
+/* Queue the notification left open for batching, with nus_tx_mutex held */
+static void tx_tail_flush(struct nus_conn *slot)
 {
-	if (!data || len == 0) {
-		return -EINVAL;
+	if (slot->tx_tail) {
+		k_fifo_put(&slot->tx_queue, slot->tx_tail);
+		slot->tx_tail = NULL;
 	}
+}
+
+static void batch_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct nus_conn *slot = CONTAINER_OF(dwork, struct nus_conn, batch_work);
+
+	k_mutex_lock(&nus_tx_mutex, K_FOREVER);
+	tx_tail_flush(slot);
+	k_mutex_unlock(&nus_tx_mutex);
+
+	k_work_reschedule(&send_work, K_NO_WAIT);
+}
 
-	if (!current_conn) {
+/* Queue data for one connection */
+static int tx_queue(struct nus_conn *slot, const uint8_t *data, uint16_t len, k_timepoint_t end)
+{
+	struct net_buf *bufs[CONFIG_BLE_NUS_TX_BUF_COUNT];
+	struct bt_conn *conn;
+	size_t count = 0;
+	size_t needed = 0;
+	size_t most;
+	size_t room;
+	uint16_t mtu;
+	int err = 0;
+
+	conn = nus_conn_ref(slot);
+	if (!conn) {
 		return -ENOTCONN;
 	}
 
-	if (!nus_notifications_enabled) {
+	if (!slot->ready) {
+		bt_conn_unref(conn);
 		return -EACCES;
 	}
 
-	if (k_sem_take(&nus_tx_sem, K_MSEC(BLE_TX_TIMEOUT_MS)) != 0) {
-		LOG_WRN("TX semaphore timeout - previous send may have failed");
-		return -ETIMEDOUT;
+	mtu = MIN(bt_nus_get_mtu(conn), BLE_TX_DATA_SIZE);
+	most = DIV_ROUND_UP((size_t)len, mtu);
+
+	/* Even with the open notification, more than the queue can hold */
+	if (most > ARRAY_SIZE(bufs) + 1) {
+		bt_conn_unref(conn);
+		return -EMSGSIZE;
 	}
 
-	int ret = bt_nus_send(NULL, data, len);
+	/* Buffers for the whole data are taken before the lock, so that the mutex is never held
+	 * while waiting for the queues to empty. Those left over by the open notification are
+	 * given back
+	 */
+	while (count < MIN(most, ARRAY_SIZE(bufs))) {
+		struct net_buf *buf = net_buf_alloc(&nus_tx_pool, sys_timepoint_timeout(end));
 
-	if (ret != 0) {
-		k_sem_give(&nus_tx_sem);
+		if (!buf) {
+			break;
+		}
+
+		bufs[count++] = buf;
 	}
 
-	return ret;
-}
+	/* The notifications of a write are queued back to back */
+	k_mutex_lock(&nus_tx_mutex, K_FOREVER);
 
-bool ble_nus_module_is_connected(void)
-{
-	return current_conn != NULL;
-}
+	if (slot->conn != conn) {
+		/* Disconnected while waiting */
+		err = -ENOTCONN;
+		goto unlock;
+	}
 
-struct bt_conn *ble_nus_module_get_connection(void)
-{
-	return current_conn;
+	if (slot->tx_tail && slot->tx_tail->len >= mtu) {
+		tx_tail_flush(slot);
+	}
+
+	/* The start of the data goes into the notification still open for batching */
+	room = slot->tx_tail ? mtu - slot->tx_tail->len : 0;
+	needed = DIV_ROUND_UP(len - MIN(len, room), mtu);
+
+	if (needed > ARRAY_SIZE(bufs)) {
+		err = -EMSGSIZE;
+		goto unlock;
+	}
+
+	/* All or nothing, so the phone never receives a partial write */
+	if (needed > count) {
+		LOG_DBG("TX queue full, %u bytes not queued", len);
+		err = -EAGAIN;
+		goto unlock;
+	}
+
+	for (size_t offset = 0, i = 0; offset < len;) {
+		size_t chunk;
+
+		if (!slot->tx_tail) {
+			slot->tx_tail = bufs[i++];
+		}
+
+		chunk = MIN(len - offset, (size_t)(mtu - slot->tx_tail->len));
+		net_buf_add_mem(slot->tx_tail, &data[offset], chunk);
+		offset += chunk;
+
+		if (slot->tx_tail->len == mtu) {
+			tx_tail_flush(slot);
+		}
+	}
+
+	/* The window starts with the first write into the open notification */
+	if (slot->tx_tail) {
+		k_work_schedule(&slot->batch_work, K_MSEC(CONFIG_BLE_NUS_TX_BATCH_MS));
+	}
+
+unlock:
+	k_mutex_unlock(&nus_tx_mutex);
+	bt_conn_unref(conn);
+
+	/* Either all of them or none were used */
+	for (size_t i = (err == 0) ? needed : 0; i < count; i++) {
+		net_buf_unref(bufs[i]);
+	}
+
+	if (err == 0) {
+		k_work_reschedule(&send_work, K_NO_WAIT);
+	}
+
+	return err;
 }
 
-bool ble_nus_module_is_ready(void)
+int ble_nus_module_send(uint8_t conn_id, const uint8_t *data, uint16_t len, k_timeout_t timeout)
 {
-	return current_conn != NULL && nus_notifications_enabled;
-}
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int none = -ENOTCONN;
+	bool queued = false;
 
-static struct k_work send_work;
-static uint8_t tx_buffer[BLE_TX_BUFFER_SIZE];
-static size_t tx_len;
-static K_MUTEX_DEFINE(tx_buf_mutex);
+	if (!data || len == 0) {
+		return -EINVAL;
+	}
 
-static void send_work_handler(struct k_work *work)
+	if (conn_id != BLE_NUS_CONN_ID_ALL) {
+		if (conn_id >= ARRAY_SIZE(nus_conns)) {
+			return -ENOTCONN;
+		}
+
+		return tx_queue(&nus_conns[conn_id], data, len, end);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+		int err = tx_queue(&nus_conns[i], data, len, end);
+
+		if (err == 0) {
+			queued = true;
+		} else if (err == -EACCES) {
+			none = err;
+		} else if (err != -ENOTCONN) {
+			return err;
+		}
+	}
+
+	return queued ? 0 : none;
+}
+
+int ble_nus_module_link_get(uint8_t conn_id, struct ble_nus_link_info *link)
 {
-	uint8_t local_buf[BLE_TX_BUFFER_SIZE];
-	size_t local_len;
+	struct bt_conn *conn;
+	struct bt_conn_info info;
+	int err;
 
-	k_mutex_lock(&tx_buf_mutex, K_FOREVER);
-	if (tx_len == 0) {
-		k_mutex_unlock(&tx_buf_mutex);
-		return;
+	if (conn_id >= ARRAY_SIZE(nus_conns)) {
+		return -ENOTCONN;
 	}
-	local_len = tx_len;
-	memcpy(local_buf, tx_buffer, tx_len);
-	tx_len = 0;
-	k_mutex_unlock(&tx_buf_mutex);
 
-	int err = ble_nus_module_send(local_buf, local_len);
+	conn = nus_conn_ref(&nus_conns[conn_id]);
+	if (!conn) {
+		return -ENOTCONN;
+	}
 
-	if (err == 0) {
-		LOG_DBG("Data sent successfully (%zu bytes)", local_len);
-	} else {
-		LOG_ERR("Failed to send data: %d", err);
+	err = bt_conn_get_info(conn, &info);
+	if (err) {
+		bt_conn_unref(conn);
+		return err;
 	}
+
+	memset(link, 0, sizeof(*link));
+	link->interval = info.le.interval;
+	link->latency = info.le.latency;
+	link->timeout = info.le.timeout;
+	link->mtu = bt_gatt_get_mtu(conn);
+
+#if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+	link->tx_len = info.le.data_len->tx_max_len;
+	link->rx_len = info.le.data_len->rx_max_len;
+#endif
+
+#if defined(CONFIG_BT_USER_PHY_UPDATE)
+	link->tx_phy = info.le.phy->tx_phy;
+	link->rx_phy = info.le.phy->rx_phy;
+#endif
+
+	bt_conn_unref(conn);
+
+	return 0;
 }
 
-static void queue_ble_send(const uint8_t *data, size_t len)
+bool ble_nus_module_is_connected(void)
 {
-	if (len > sizeof(tx_buffer)) {
-		LOG_ERR("Data too large (%zu bytes, max %zu)", len, sizeof(tx_buffer));
-		return;
+	return nus_conn_count() > 0;
+}
+
+/* First connected phone */
+struct bt_conn *ble_nus_module_get_connection(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+		if (nus_conns[i].conn) {
+			return nus_conns[i].conn;
+		}
 	}
 
-	k_mutex_lock(&tx_buf_mutex, K_FOREVER);
-	if (tx_len) {
-		LOG_WRN("Previous message not sent yet, overwriting");
+	return NULL;
+}
+
+bool ble_nus_module_is_ready(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+		if (nus_conns[i].conn && nus_conns[i].ready) {
+			return true;
+		}
 	}
-	memcpy(tx_buffer, data, len);
-	tx_len = len;
-	k_mutex_unlock(&tx_buf_mutex);
 
-	k_work_submit(&send_work);
+	return false;
 }
 
 static void default_data_received_cb(struct bt_conn *conn, const uint8_t *data, uint16_t len)
@@ -571,7 +1182,9 @@ static void default_connection_status_cb(struct bt_conn *conn, bool connected)
 
 static void default_ready_cb(struct bt_conn *conn, bool ready)
 {
-	if (!conn) {
+	struct nus_conn *slot = nus_conn_get(conn);
+
+	if (!conn || !slot) {
 		return;
 	}
 
@@ -579,8 +1192,14 @@ static void default_ready_cb(struct bt_conn *conn, bool ready)
 		LOG_DBG("Notifications enabled - can send data to phone");
 
 		const char *msg = "Device ready\r\n";
+		int err;
 
-		queue_ble_send((uint8_t *)msg, strlen(msg));
+		/* Called from the system workqueue, which also empties the queue */
+		err = ble_nus_module_send(nus_conn_id(slot), (const uint8_t *)msg, strlen(msg),
+					  K_NO_WAIT);
+		if (err) {
+			LOG_WRN("Failed to queue ready message: %d", err);
+		}
 	}
 }
 
@@ -592,7 +1211,12 @@ static int ble_nus_module_auto_init(void)
 	LOG_INF("  BLE NUS module running");
 	LOG_INF("=================================");
 
-	k_work_init(&send_work, send_work_handler);
+	k_work_init_delayable(&send_work, send_work_handler);
+
+	for (size_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+		k_fifo_init(&nus_conns[i].tx_queue);
+		k_work_init_delayable(&nus_conns[i].batch_work, batch_work_handler);
+	}
 
 	struct ble_nus_module_config ble_config = {
 		.data_received_cb = default_data_received_cb,
@@ -603,15 +1227,19 @@ static int ble_nus_module_auto_init(void)
 	err = ble_nus_module_init(&ble_config);
 	if (err) {
 		LOG_ERR("BLE init failed: %d", err);
+		mdm_health_module_status_set(MDM_HEALTH_MODULE_BLE_NUS, err);
 		return err;
 	}
 
 	err = ble_nus_module_enable();
 	if (err) {
 		LOG_ERR("BLE enable failed: %d", err);
+		mdm_health_module_status_set(MDM_HEALTH_MODULE_BLE_NUS, err);
 		return err;
 	}
 
+	mdm_health_module_status_set(MDM_HEALTH_MODULE_BLE_NUS, 0);
+
 	LOG_INF("Advertising as: %s", CONFIG_BT_DEVICE_NAME);
 
 	return 0;
@@ -619,15 +1247,67 @@ static int ble_nus_module_auto_init(void)
 
 SYS_INIT(ble_nus_module_auto_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
 
-#if IS_ENABLED(CONFIG_MDM_BLE_NUS_ZBUS_LOGGING)
+/* Queue data from the other domain for one connection and answer with its status */
+static void tx_chan_send(uint8_t conn_id, const struct ble_nus_module_message *msg)
+{
+	struct ble_nus_tx_status status = {
+		.result = BLE_NUS_TX_QUEUED,
+		.timestamp = msg->timestamp,
+		.len = msg->len,
+		.conn_id = conn_id,
+	};
+
+	status.err = ble_nus_module_send(conn_id, msg->data, MIN(msg->len, sizeof(msg->data)),
+					 K_NO_WAIT);
+	if (status.err == -EAGAIN && conn_id < ARRAY_SIZE(nus_conns)) {
+		status.result = BLE_NUS_TX_BUSY;
+		atomic_set(&nus_conns[conn_id].tx_busy, 1);
+	} else if (status.err) {
+		status.result = BLE_NUS_TX_FAILED;
+	}
+
+	tx_status_publish(&status);
+}
 
-static void log_ble_nus_message(const struct zbus_channel *chan)
+/* Data for the phones from the other domain, called in the proxy agent's receive thread */
+static void nus_tx_listener_cb(const struct zbus_channel *chan)
 {
 	const struct ble_nus_module_message *msg = zbus_chan_const_msg(chan);
-	LOG_INF("=== BLE NUS ZBUS Message Received ===");
+	bool sent = false;
+
+	if (msg->conn_id != BLE_NUS_CONN_ID_ALL) {
+		tx_chan_send(msg->conn_id, msg);
+		return;
+	}
+
+	/* Answered for each phone, so that the sender only publishes again for the busy ones */
+	for (uint8_t i = 0; i < ARRAY_SIZE(nus_conns); i++) {
+		if (nus_conns[i].conn) {
+			tx_chan_send(i, msg);
+			sent = true;
+		}
+	}
+
+	if (!sent) {
+		tx_chan_send(BLE_NUS_CONN_ID_ALL, msg);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(nus_tx_listener, nus_tx_listener_cb);
+ZBUS_CHAN_ADD_OBS(BLE_NUS_TX_CHAN, nus_tx_listener, 0);
+
+#if IS_ENABLED(CONFIG_MDM_BLE_NUS_ZBUS_LOGGING)
+
+/* Called in the logging thread */
+static void log_ble_nus_message(const void *message, uint32_t time)
+{
+	const struct ble_nus_module_message *msg = message;
+	LOG_INF("=== BLE NUS ZBUS Message Received at %u ms ===", time);
 	LOG_INF("Type: %s", ble_message_type_to_string(msg->type));
 	LOG_INF("Timestamp: %u ms", msg->timestamp);
 	LOG_INF("Length: %u bytes", msg->len);
+	LOG_INF("Connection: %u", msg->conn_id);
+	LOG_INF("Chunk: write %u, offset %u of %u bytes", msg->seq, msg->offset, msg->total_len);
 
 	/* Try to print as string if printable */
 	bool printable = true;
@@ -650,7 +1330,6 @@ static void log_ble_nus_message(const struct zbus_channel *chan)
 	LOG_INF("=============================");
 }
 
-ZBUS_LISTENER_DEFINE(ble_nus_logger, log_ble_nus_message);
-ZBUS_CHAN_ADD_OBS(BLE_NUS_CHAN, ble_nus_logger, 0);
+MDM_ZBUS_LOG_CHAN_ADD(BLE_NUS_CHAN, log_ble_nus_message);
 
 #endif /* CONFIG_MDM_BLE_NUS_ZBUS_LOGGING */
@@ -9,6 +9,10 @@
 
 #include <zephyr/zbus/zbus.h>
 
+#if defined(CONFIG_MDM_BLE_NUS_CACHE)
+#include "mdm_cache.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -16,24 +20,198 @@ extern "C" {
 #define BLE_NUS_MODULE_MESSAGE_SIZE 100
 #define BLE_MAX_PRINT_LEN           256
 
+/* Connection id of a BLE_NUS_TX_CHAN message for every connected phone */
+#define BLE_NUS_CONN_ID_ALL 0xFF
+
 /* Channels provided by this module */
-ZBUS_CHAN_DECLARE(BLE_NUS_CHAN);
+ZBUS_CHAN_DECLARE(BLE_NUS_CHAN, BLE_NUS_TX_CHAN, BLE_NUS_TX_STATUS_CHAN);
+
+/* Channel list of this module, see mdm_channels.h. The other domain sends data to the phone on
+ * BLE_NUS_TX_CHAN, and the runner answers every message on BLE_NUS_TX_STATUS_CHAN.
+ */
+#define MDM_BLE_NUS_CHANNELS(X)								\
+	X(BLE_NUS_CHAN, struct ble_nus_module_message, RUNNER, MDM_BLE_NUS_PROXY_NODE,		\
+	  MDM_LINK_ID_BLE_NUS, &ble_nus_link_codec, CONFIG_MDM_BLE_NUS_LINK_LANE, 0)		\
+	X(BLE_NUS_TX_CHAN, struct ble_nus_module_message, CONTROLLER, MDM_BLE_NUS_PROXY_NODE,	\
+	  MDM_LINK_ID_BLE_NUS_TX, &ble_nus_link_codec, CONFIG_MDM_BLE_NUS_LINK_LANE,		\
+	  IS_ENABLED(CONFIG_MDM_BLE_NUS_TX_RELIABLE) ? MDM_LINK_CHAN_RELIABLE : 0)		\
+	X(BLE_NUS_TX_STATUS_CHAN, struct ble_nus_tx_status, RUNNER, MDM_BLE_NUS_PROXY_NODE,	\
+	  MDM_LINK_ID_BLE_NUS_TX_STATUS, NULL, MDM_LINK_LANE_DEFAULT, 0)
+
+#if defined(CONFIG_MDM_BLE_NUS_CACHE)
+/* Latest BLE_NUS_CHAN message received by the controller */
+MDM_SHADOW_CACHE_DECLARE(ble_nus_cache);
+#endif
 
 enum ble_msg_type {
 	BLE_RECV,
+	BLE_SEND,
 };
+/* Writes of the phone longer than BLE_NUS_MODULE_MESSAGE_SIZE are published on BLE_NUS_CHAN as
+ * several chunks, in order, with the same seq and increasing offsets. The write is complete when
+ * offset + len reaches total_len. The chunks of a write are never interleaved with the chunks of
+ * another connection.
+ */
 struct ble_nus_module_message {
 	enum ble_msg_type type;
 	uint8_t data[BLE_NUS_MODULE_MESSAGE_SIZE];
 	uint16_t len;
 	uint32_t timestamp;
+
+	/** Number of the write the chunk belongs to, wraps around */
+	uint16_t seq;
+
+	/** Offset of the chunk in the write */
+	uint16_t offset;
+
+	/** Length of the whole write */
+	uint16_t total_len;
+
+	/** Connection of the phone that wrote the data, or on BLE_NUS_TX_CHAN the connection to
+	 *  send the data to, BLE_NUS_CONN_ID_ALL for every connected phone
+	 */
+	uint8_t conn_id;
+};
+
+#if defined(CONFIG_MDM_BLE_NUS_REASSEMBLY)
+struct net_buf;
+
+/* Complete writes of the phone, reassembled by the controller from the chunks on BLE_NUS_CHAN */
+ZBUS_CHAN_DECLARE(BLE_NUS_WRITE_CHAN);
+
+/**
+ * Message of BLE_NUS_WRITE_CHAN. The data is not copied into the message: buf holds the whole
+ * write and is released after the publish, so observers that keep it must take a reference
+ * with net_buf_ref() and release it with net_buf_unref().
+ */
+struct ble_nus_write {
+	struct net_buf *buf;
+
+	/** Number of the write */
+	uint16_t seq;
+
+	/** Timestamp of its first chunk */
+	uint32_t timestamp;
+
+	/** Connection of the phone that wrote the data */
+	uint8_t conn_id;
+};
+#endif /* CONFIG_MDM_BLE_NUS_REASSEMBLY */
+
+/** Outcome of a BLE_NUS_TX_CHAN message */
+enum ble_nus_tx_result {
+	/** The data was queued for the phone */
+	BLE_NUS_TX_QUEUED,
+
+	/** The TX queue of the connection was full and the data was not queued, publish it again
+	 *  after BLE_NUS_TX_READY of the connection
+	 */
+	BLE_NUS_TX_BUSY,
+
+	/** The TX queue of the connection emptied after data was refused, not an answer to a
+	 *  message
+	 */
+	BLE_NUS_TX_READY,
+
+	/** The data was not queued, see err */
+	BLE_NUS_TX_FAILED,
+};
+
+struct ble_nus_tx_status {
+	enum ble_nus_tx_result result;
+
+	/** Error of ble_nus_module_send() with BLE_NUS_TX_FAILED, such as -ENOTCONN */
+	int32_t err;
+
+	/** Timestamp of the BLE_NUS_TX_CHAN message, to match the answer to the message */
+	uint32_t timestamp;
+
+	/** Length of the data of the message */
+	uint16_t len;
+
+	/** Connection the status is for. A message for BLE_NUS_CONN_ID_ALL is answered once for
+	 *  each connected phone, or once with BLE_NUS_CONN_ID_ALL when there is none
+	 */
+	uint8_t conn_id;
 };
 
+#if defined(CONFIG_MDM_LINK)
+struct mdm_link_codec;
+
+/** Link encoding that only puts the used part of the data on the wire */
+extern const struct mdm_link_codec ble_nus_link_codec;
+#endif
+
+#if defined(CONFIG_MDM_BLE_NUS_RUNNER)
+/** Link parameters of a connection with a phone */
+struct ble_nus_link_info {
+	/** Connection interval in units of 1.25 ms */
+	uint16_t interval;
+
+	/** Peripheral latency in connection events */
+	uint16_t latency;
+
+	/** Supervision timeout in units of 10 ms */
+	uint16_t timeout;
+
+	/** ATT MTU */
+	uint16_t mtu;
+
+	/** Maximum LL payload in each direction, 0 without CONFIG_BT_USER_DATA_LEN_UPDATE */
+	uint16_t tx_len;
+	uint16_t rx_len;
+
+	/** PHY in each direction, 0 without CONFIG_BT_USER_PHY_UPDATE */
+	uint8_t tx_phy;
+	uint8_t rx_phy;
+};
+
+/**
+ * @brief Get the link parameters negotiated with a connected phone.
+ *
+ * @param conn_id Connection id, below CONFIG_BLE_NUS_MAX_CONN.
+ * @param link Filled with the parameters.
+ *
+ * @retval 0 On success.
+ * @retval -ENOTCONN No phone on this connection.
+ */
+int ble_nus_module_link_get(uint8_t conn_id, struct ble_nus_link_info *link);
+
+/**
+ * @brief Queue data for a connected phone.
+ *
+ * The data is split into notifications of the ATT MTU negotiated on the connection, sent in order.
+ * Each connection has its own queue, and a share of the CONFIG_BT_BUF_ACL_TX_COUNT notifications
+ * in flight. Consecutive writes are batched into the same notification for up to
+ * CONFIG_BLE_NUS_TX_BATCH_MS. The data is copied, nothing is queued for a phone when its queue
+ * cannot take all of it.
+ *
+ * With BLE_NUS_CONN_ID_ALL, the data is queued for every phone that enabled notifications, and
+ * the first error of a connection is returned. The data may have been queued for the others.
+ *
+ * @param conn_id Connection id, below CONFIG_BLE_NUS_MAX_CONN, or BLE_NUS_CONN_ID_ALL.
+ * @param data Data to send.
+ * @param len Length of the data.
+ * @param timeout Time to wait for room in the queue. Must be K_NO_WAIT in the system workqueue,
+ *		  which empties the queue.
+ *
+ * @retval 0 All of the data was queued.
+ * @retval -EINVAL No data.
+ * @retval -ENOTCONN No phone on this connection, or no phone connected.
+ * @retval -EACCES The phone did not enable notifications, or none of them did.
+ * @retval -EMSGSIZE More notifications than CONFIG_BLE_NUS_TX_BUF_COUNT.
+ * @retval -EAGAIN The queue stayed full until the timeout, retry later.
+ */
+int ble_nus_module_send(uint8_t conn_id, const uint8_t *data, uint16_t len, k_timeout_t timeout);
+#endif /* CONFIG_MDM_BLE_NUS_RUNNER */
+
 static inline const char *ble_message_type_to_string(enum ble_msg_type type)
 {
 	switch (type) {
 	case BLE_RECV:
 		return "BLE_RECV";
+	case BLE_SEND:
+		return "BLE_SEND";
 	default:
 		return "UNKNOWN";
 	}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "ble_nus.h"
+#include "mdm_link.h"
+
+/* Wire layout: type (1), conn_id (1), timestamp (4, LE), seq (2, LE), offset (2, LE),
+ * total_len (2, LE), len (1), followed by len bytes of data
+ */
+#define BLE_NUS_WIRE_HDR_SIZE 13U
+
+BUILD_ASSERT(BLE_NUS_MODULE_MESSAGE_SIZE <= UINT8_MAX);
+
+static int ble_nus_encode(const void *msg, uint8_t *buf, size_t size,
+			  const struct mdm_link_codec_ctx *ctx)
+{
+	const struct ble_nus_module_message *nus_msg = msg;
+	uint16_t len = MIN(nus_msg->len, BLE_NUS_MODULE_MESSAGE_SIZE);
+
+	ARG_UNUSED(ctx);
+
+	if (size < BLE_NUS_WIRE_HDR_SIZE + len) {
+		return -EMSGSIZE;
+	}
+
+	buf[0] = nus_msg->type;
+	buf[1] = nus_msg->conn_id;
+	sys_put_le32(nus_msg->timestamp, &buf[2]);
+	sys_put_le16(nus_msg->seq, &buf[6]);
+	sys_put_le16(nus_msg->offset, &buf[8]);
+	sys_put_le16(nus_msg->total_len, &buf[10]);
+	buf[12] = len;
+	memcpy(&buf[BLE_NUS_WIRE_HDR_SIZE], nus_msg->data, len);
+
+	return BLE_NUS_WIRE_HDR_SIZE + len;
+}
+
+static int ble_nus_decode(const uint8_t *buf, size_t len, void *msg,
+			  const struct mdm_link_codec_ctx *ctx)
+{
+	struct ble_nus_module_message *nus_msg = msg;
+	uint8_t data_len;
+
+	ARG_UNUSED(ctx);
+
+	if (len < BLE_NUS_WIRE_HDR_SIZE) {
+		return -EBADMSG;
+	}
+
+	data_len = buf[12];
+
+	if (data_len > BLE_NUS_MODULE_MESSAGE_SIZE || len != BLE_NUS_WIRE_HDR_SIZE + data_len) {
+		return -EBADMSG;
+	}
+
+	nus_msg->type = buf[0];
+	nus_msg->conn_id = buf[1];
+	nus_msg->timestamp = sys_get_le32(&buf[2]);
+	nus_msg->seq = sys_get_le16(&buf[6]);
+	nus_msg->offset = sys_get_le16(&buf[8]);
+	nus_msg->total_len = sys_get_le16(&buf[10]);
+	nus_msg->len = data_len;
+	memcpy(nus_msg->data, &buf[BLE_NUS_WIRE_HDR_SIZE], data_len);
+	memset(&nus_msg->data[data_len], 0, sizeof(nus_msg->data) - data_len);
+
+	return 0;
+}
+
+const struct mdm_link_codec ble_nus_link_codec = {
+	.encode = ble_nus_encode,
+	.decode = ble_nus_decode,
+};
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "ble_nus.h"
+
+static int cmd_link(const struct shell *sh, size_t argc, char **argv)
+{
+	struct ble_nus_link_info link;
+	bool connected = false;
+
+	for (uint8_t id = 0; id < CONFIG_BLE_NUS_MAX_CONN; id++) {
+		if (ble_nus_module_link_get(id, &link)) {
+			continue;
+		}
+
+		connected = true;
+
+		shell_print(sh, "connection %u:", id);
+		shell_print(sh, "  interval %u.%02u ms, latency %u, timeout %u ms",
+			    link.interval * 125 / 100, link.interval * 125 % 100, link.latency,
+			    link.timeout * 10);
+		shell_print(sh, "  ATT MTU %u", link.mtu);
+		shell_print(sh, "  data length TX %u, RX %u bytes", link.tx_len, link.rx_len);
+		shell_print(sh, "  PHY TX %u, RX %u", link.tx_phy, link.rx_phy);
+	}
+
+	if (!connected) {
+		shell_error(sh, "No phone connected");
+		return -ENOTCONN;
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_ble_nus,
+	SHELL_CMD(link, NULL, "Print the link parameters negotiated with the phones", cmd_link),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(ble_nus, &sub_ble_nus, "BLE NUS module", NULL);
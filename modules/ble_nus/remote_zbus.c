@@ -4,10 +4,15 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <zephyr/net_buf.h>
 #include <zephyr/zbus/zbus.h>
 #include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
 
 #include "ble_nus.h"
+#include "mdm_link.h"
+#include "mdm_channels.h"
+#include "mdm_cache.h"
+#include "mdm_zbus_log.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(mdm_ble_nus_module, CONFIG_APP_LOG_LEVEL);
@@ -16,28 +21,126 @@ LOG_MODULE_REGISTER(mdm_ble_nus_module, CONFIG_APP_LOG_LEVEL);
 #error "MDM_BLE_NUS_PROXY_NODE must be defined to use multi-domain zbus channels for BLE NUS module"
 #endif
 
-
 /* This file is for the non-runner/controller side: the controller has the shadow channel, and the
  * runner has the main channel
  */
-ZBUS_SHADOW_CHAN_DEFINE(
-	BLE_NUS_CHAN,
-	struct ble_nus_module_message,
-	MDM_BLE_NUS_PROXY_NODE,
-	NULL,
-	ZBUS_OBSERVERS_EMPTY,
-	ZBUS_MSG_INIT(0)
-);
+MDM_CHANNELS_DEFINE(MDM_BLE_NUS_CHANNELS, CONTROLLER)
 
-#if IS_ENABLED(CONFIG_MDM_BLE_NUS_ZBUS_LOGGING)
+#if IS_ENABLED(CONFIG_MDM_BLE_NUS_CACHE)
+MDM_SHADOW_CACHE_DEFINE(ble_nus_cache, BLE_NUS_CHAN, struct ble_nus_module_message);
+#endif
+
+#if IS_ENABLED(CONFIG_MDM_BLE_NUS_REASSEMBLY)
+
+ZBUS_CHAN_DEFINE(BLE_NUS_WRITE_CHAN, struct ble_nus_write, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+
+NET_BUF_POOL_FIXED_DEFINE(ble_nus_write_pool, CONFIG_MDM_BLE_NUS_WRITE_BUF_COUNT,
+			  CONFIG_MDM_BLE_NUS_WRITE_SIZE_MAX, 0, NULL);
+
+/* Only used by the listener: write being reassembled */
+static struct net_buf *rx_buf;
+static uint16_t rx_seq;
+static uint32_t rx_timestamp;
+static uint16_t rx_total_len;
+static uint8_t rx_conn_id;
+
+static void rx_drop(const char *reason)
+{
+	if (rx_buf) {
+		LOG_WRN("Dropping write %u after %u bytes: %s", rx_seq, rx_buf->len, reason);
+		net_buf_unref(rx_buf);
+		rx_buf = NULL;
+	}
+}
 
-static void log_ble_nus_message(const struct zbus_channel *chan)
+/* Called in the receive thread of the proxy agent or link, chunks arrive in order */
+static void ble_nus_reassembly_cb(const struct zbus_channel *chan)
 {
 	const struct ble_nus_module_message *msg = zbus_chan_const_msg(chan);
-	LOG_INF("=== BLE NUS ZBUS Message Received ===");
+	struct ble_nus_write write;
+	int err;
+
+	if (msg->type != BLE_RECV) {
+		return;
+	}
+
+	if (msg->offset == 0) {
+		rx_drop("next write started");
+
+		if (msg->total_len > CONFIG_MDM_BLE_NUS_WRITE_SIZE_MAX) {
+			LOG_WRN("Dropping %u byte write %u, too large", msg->total_len, msg->seq);
+			return;
+		}
+
+		rx_buf = net_buf_alloc(&ble_nus_write_pool, K_NO_WAIT);
+		if (!rx_buf) {
+			LOG_WRN("Dropping write %u, no reassembly buffer", msg->seq);
+			return;
+		}
+
+		rx_seq = msg->seq;
+		rx_timestamp = msg->timestamp;
+		rx_total_len = msg->total_len;
+		rx_conn_id = msg->conn_id;
+	} else if (!rx_buf) {
+		/* The start of the write was dropped */
+		return;
+	} else if (msg->seq != rx_seq || msg->conn_id != rx_conn_id || msg->offset != rx_buf->len) {
+		rx_drop("chunk missing");
+		return;
+	} else if (msg->total_len != rx_total_len) {
+		rx_drop("length changed");
+		return;
+	}
+
+	/* A chunk may not run past the length checked when the write started, nor the buffer */
+	if (msg->len > sizeof(msg->data) || msg->offset + msg->len > rx_total_len ||
+	    msg->len > net_buf_tailroom(rx_buf)) {
+		rx_drop("invalid chunk");
+		return;
+	}
+
+	net_buf_add_mem(rx_buf, msg->data, msg->len);
+
+	if (rx_buf->len < rx_total_len) {
+		return;
+	}
+
+	write = (struct ble_nus_write){
+		.buf = rx_buf,
+		.seq = rx_seq,
+		.timestamp = rx_timestamp,
+		.conn_id = rx_conn_id,
+	};
+
+	err = zbus_chan_pub(&BLE_NUS_WRITE_CHAN, &write, K_NO_WAIT);
+	if (err) {
+		LOG_WRN("Failed to publish write %u: %d", rx_seq, err);
+	}
+
+	/* Observers that keep the write hold their own reference */
+	net_buf_unref(rx_buf);
+	rx_buf = NULL;
+}
+
+ZBUS_LISTENER_DEFINE(ble_nus_reassembly, ble_nus_reassembly_cb);
+ZBUS_CHAN_ADD_OBS(BLE_NUS_CHAN, ble_nus_reassembly, 0);
+
+#endif /* CONFIG_MDM_BLE_NUS_REASSEMBLY */
+
+#if IS_ENABLED(CONFIG_MDM_BLE_NUS_ZBUS_LOGGING)
+
+/* Called in the logging thread */
+static void log_ble_nus_message(const void *message, uint32_t time)
+{
+	const struct ble_nus_module_message *msg = message;
+	LOG_INF("=== BLE NUS ZBUS Message Received at %u ms ===", time);
 	LOG_INF("Type: %s", ble_message_type_to_string(msg->type));
 	LOG_INF("Timestamp: %u ms", msg->timestamp);
 	LOG_INF("Length: %u bytes", msg->len);
+	LOG_INF("Connection: %u", msg->conn_id);
+	LOG_INF("Chunk: write %u, offset %u of %u bytes", msg->seq, msg->offset, msg->total_len);
 
 	/* Try to print as string if printable */
 	bool printable = true;
@@ -60,7 +163,6 @@ static void log_ble_nus_message(const struct zbus_channel *chan)
 	LOG_INF("=============================");
 }
 
-ZBUS_LISTENER_DEFINE(ble_nus_logger, log_ble_nus_message);
-ZBUS_CHAN_ADD_OBS(BLE_NUS_CHAN, ble_nus_logger, 0);
+MDM_ZBUS_LOG_CHAN_ADD(BLE_NUS_CHAN, log_ble_nus_message);
 
 #endif /* CONFIG_MDM_BLE_NUS_ZBUS_LOGGING */
@@ -29,6 +29,11 @@
 #include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
 
 #include "channel_sounding.h"
+#include "mdm_link.h"
+#include "mdm_channels.h"
+#include "mdm_zbus_log.h"
+#include "mdm_stats.h"
+#include "mdm_health.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(channel_sounding, CONFIG_MDM_CHANNEL_SOUNDING_LOG_LEVEL);
@@ -40,16 +45,7 @@ LOG_MODULE_REGISTER(channel_sounding, CONFIG_MDM_CHANNEL_SOUNDING_LOG_LEVEL);
 /* This file is for the runner side: the controller has the shadow channel, and the
  * runner has the main channel
  */
-ZBUS_CHAN_DEFINE(
-	CS_DISTANCE_CHAN,
-	struct cs_distance_msg,
-	NULL,
-	NULL,
-	ZBUS_OBSERVERS_EMPTY,
-	ZBUS_MSG_INIT(0)
-);
-
-ZBUS_PROXY_ADD_CHAN(MDM_CHANNEL_SOUNDING_PROXY_NODE, CS_DISTANCE_CHAN);
+MDM_CHANNELS_DEFINE(MDM_CHANNEL_SOUNDING_CHANNELS, RUNNER)
 
 #define CON_STATUS_LED DK_LED1
 
@@ -171,6 +167,41 @@ static cs_de_dist_estimates_t get_distance(uint8_t ap)
 	return averaged_result;
 }
 
+/* Fills the channel message in place instead of publishing a copy built on the stack */
+static int publish_distance(uint8_t ap, const cs_de_dist_estimates_t *distance)
+{
+	struct cs_distance_msg *msg;
+	int ret;
+
+	ret = mdm_link_tx_ready(&CS_DISTANCE_CHAN);
+	if (ret) {
+		return ret;
+	}
+
+	ret = zbus_chan_claim(&CS_DISTANCE_CHAN, K_NO_WAIT);
+	if (ret) {
+		mdm_stats_pub_failed(&CS_DISTANCE_CHAN, ret);
+		return ret;
+	}
+
+	msg = zbus_chan_msg(&CS_DISTANCE_CHAN);
+	msg->type = CS_DISTANCE_MEASUREMENT;
+	msg->antenna_path = ap;
+	msg->ifft = distance->ifft;
+	msg->phase_slope = distance->phase_slope;
+	msg->rtt = distance->rtt;
+	msg->timestamp = k_uptime_get_32();
+
+	(void)zbus_chan_finish(&CS_DISTANCE_CHAN);
+
+	ret = zbus_chan_notify(&CS_DISTANCE_CHAN, K_NO_WAIT);
+	if (ret) {
+		mdm_stats_pub_failed(&CS_DISTANCE_CHAN, ret);
+	}
+
+	return ret;
+}
+
 static void ranging_data_cb(struct bt_conn *conn, uint16_t ranging_counter, int err)
 {
 	ARG_UNUSED(conn);
@@ -642,21 +673,26 @@ static void channel_sounding_thread(void *p1, void *p2, void *p3)
 		LOG_DBG("Bluetooth already enabled");
 	} else if (err) {
 		LOG_ERR("Bluetooth init failed (err %d)", err);
+		mdm_health_module_status_set(MDM_HEALTH_MODULE_CHANNEL_SOUNDING, err);
 		return;
 	}
 
 	err = scan_init();
 	if (err) {
 		LOG_ERR("Scan init failed (err %d)", err);
+		mdm_health_module_status_set(MDM_HEALTH_MODULE_CHANNEL_SOUNDING, err);
 		return;
 	}
 
 	err = bt_scan_start(BT_SCAN_TYPE_SCAN_PASSIVE);
 	if (err) {
 		LOG_ERR("Scanning failed to start (err %i)", err);
+		mdm_health_module_status_set(MDM_HEALTH_MODULE_CHANNEL_SOUNDING, err);
 		return;
 	}
 
+	mdm_health_module_status_set(MDM_HEALTH_MODULE_CHANNEL_SOUNDING, 0);
+
 	/* Main connection loop - handles reconnections after disconnect */
 	while (true) {
 		k_sem_take(&sem_connected, K_FOREVER);
@@ -842,17 +878,8 @@ static void channel_sounding_thread(void *p1, void *p2, void *p3)
 						(double)distance_on_ap.phase_slope,
 						(double)distance_on_ap.rtt);
 
-					/* Publish distance measurement to zbus */
-					struct cs_distance_msg msg = {
-						.type = CS_DISTANCE_MEASUREMENT,
-						.antenna_path = ap,
-						.ifft = distance_on_ap.ifft,
-						.phase_slope = distance_on_ap.phase_slope,
-						.rtt = distance_on_ap.rtt,
-						.timestamp = k_uptime_get_32(),
-					};
-
-					int ret = zbus_chan_pub(&CS_DISTANCE_CHAN, &msg, K_NO_WAIT);
+					int ret = publish_distance(ap, &distance_on_ap);
+
 					if (ret) {
 						LOG_WRN("Failed to publish distance measurement: "
 							"%d",
@@ -874,10 +901,11 @@ K_THREAD_DEFINE(channel_sounding_tid, CONFIG_CHANNEL_SOUNDING_THREAD_STACK_SIZE,
 
 #if IS_ENABLED(CONFIG_MDM_CHANNEL_SOUNDING_ZBUS_LOGGING)
 
-static void log_cs_message(const struct zbus_channel *chan)
+/* Called in the logging thread */
+static void log_cs_message(const void *message, uint32_t time)
 {
-	const struct cs_distance_msg *msg = zbus_chan_const_msg(chan);
-	LOG_INF("=== Channel Sounding ZBUS Message Received ===");
+	const struct cs_distance_msg *msg = message;
+	LOG_INF("=== Channel Sounding ZBUS Message Received at %u ms ===", time);
 	LOG_INF("Type: %s", cs_message_type_to_string(msg->type));
 	LOG_INF("Timestamp: %u ms", msg->timestamp);
 	LOG_INF("Antenna Path: %u", msg->antenna_path);
@@ -886,7 +914,6 @@ static void log_cs_message(const struct zbus_channel *chan)
 	LOG_INF("=============================================");
 }
 
-ZBUS_LISTENER_DEFINE(cs_logger, log_cs_message);
-ZBUS_CHAN_ADD_OBS(CS_DISTANCE_CHAN, cs_logger, 0);
+MDM_ZBUS_LOG_CHAN_ADD(CS_DISTANCE_CHAN, log_cs_message);
 
 #endif /* CONFIG_MDM_CHANNEL_SOUNDING_ZBUS_LOGGING */
@@ -9,6 +9,10 @@
 
 #include <zephyr/zbus/zbus.h>
 
+#if defined(CONFIG_MDM_CHANNEL_SOUNDING_CACHE)
+#include "mdm_cache.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -16,6 +20,17 @@ extern "C" {
 /* Channels provided by this module */
 ZBUS_CHAN_DECLARE(CS_DISTANCE_CHAN);
 
+/* Channel list of this module, see mdm_channels.h */
+#define MDM_CHANNEL_SOUNDING_CHANNELS(X)							\
+	X(CS_DISTANCE_CHAN, struct cs_distance_msg, RUNNER, MDM_CHANNEL_SOUNDING_PROXY_NODE,	\
+	  MDM_LINK_ID_CS_DISTANCE, CS_DISTANCE_LINK_CODEC,					\
+	  CONFIG_MDM_CHANNEL_SOUNDING_LINK_LANE, 0)
+
+#if defined(CONFIG_MDM_CHANNEL_SOUNDING_CACHE)
+/* Latest CS_DISTANCE_CHAN message received by the controller */
+MDM_SHADOW_CACHE_DECLARE(cs_distance_cache);
+#endif
+
 enum cs_msg_type {
 	CS_DISTANCE_MEASUREMENT,
 };
@@ -43,6 +58,17 @@ struct cs_distance_msg {
 	uint32_t timestamp;
 };
 
+#if defined(CONFIG_MDM_CHANNEL_SOUNDING_COMPACT_ENCODING)
+struct mdm_link_codec;
+
+/** Link encoding with fixed-point distances, delta timestamps and packed validity flags */
+extern const struct mdm_link_codec cs_distance_link_codec;
+
+#define CS_DISTANCE_LINK_CODEC (&cs_distance_link_codec)
+#else
+#define CS_DISTANCE_LINK_CODEC NULL
+#endif
+
 static inline const char *cs_message_type_to_string(enum cs_msg_type type)
 {
 	switch (type) {
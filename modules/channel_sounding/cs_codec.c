@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <math.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "channel_sounding.h"
+#include "mdm_link.h"
+
+/* Wire layout, without padding:
+ *  - Flags (1): bits 0-2 validity of ifft, phase_slope and rtt, bits 3-5 antenna path,
+ *    bits 6-7 message type.
+ *  - Timestamp (1-5): zigzag varint of the difference to the frame time.
+ *  - Distances (3 each, LE): signed millimetres, only present for valid estimates. NaN marks
+ *    an invalid estimate, infinite and out of range distances saturate.
+ */
+#define CS_FLAG_IFFT_VALID        BIT(0)
+#define CS_FLAG_PHASE_SLOPE_VALID BIT(1)
+#define CS_FLAG_RTT_VALID         BIT(2)
+#define CS_FLAG_AP_SHIFT          3
+#define CS_FLAG_AP_MASK           0x7
+#define CS_FLAG_TYPE_SHIFT        6
+#define CS_FLAG_TYPE_MASK         0x3
+
+#define CS_DISTANCE_SIZE 3
+#define CS_DISTANCE_MAX  ((1 << 23) - 1)
+#define CS_MM_PER_METER  1000.0f
+
+static int32_t meters_to_mm(float meters)
+{
+	float mm = roundf(meters * CS_MM_PER_METER);
+
+	return (int32_t)CLAMP(mm, -CS_DISTANCE_MAX, CS_DISTANCE_MAX);
+}
+
+static uint32_t zigzag_encode(int32_t value)
+{
+	return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t zigzag_decode(uint32_t value)
+{
+	return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static int cs_distance_encode(const void *msg, uint8_t *buf, size_t size,
+			      const struct mdm_link_codec_ctx *ctx)
+{
+	const struct cs_distance_msg *cs_msg = msg;
+	const float distances[] = {cs_msg->ifft, cs_msg->phase_slope, cs_msg->rtt};
+	size_t len = 1;
+	int ret;
+
+	if (cs_msg->antenna_path > CS_FLAG_AP_MASK || cs_msg->type > CS_FLAG_TYPE_MASK) {
+		return -EINVAL;
+	}
+
+	if (size < len) {
+		return -EMSGSIZE;
+	}
+
+	buf[0] = (cs_msg->antenna_path << CS_FLAG_AP_SHIFT) | (cs_msg->type << CS_FLAG_TYPE_SHIFT);
+
+	ret = mdm_link_varint_put(zigzag_encode((int32_t)(cs_msg->timestamp - ctx->frame_time)),
+				  &buf[len], size - len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(distances); i++) {
+		if (isnan(distances[i])) {
+			continue;
+		}
+
+		if (size - len < CS_DISTANCE_SIZE) {
+			return -EMSGSIZE;
+		}
+
+		buf[0] |= BIT(i);
+		sys_put_le24((uint32_t)meters_to_mm(distances[i]), &buf[len]);
+		len += CS_DISTANCE_SIZE;
+	}
+
+	return len;
+}
+
+static int cs_distance_decode(const uint8_t *buf, size_t len, void *msg,
+			      const struct mdm_link_codec_ctx *ctx)
+{
+	struct cs_distance_msg *cs_msg = msg;
+	float distances[3];
+	uint32_t timestamp_delta;
+	size_t offset = 1;
+	int ret;
+
+	if (len < offset) {
+		return -EBADMSG;
+	}
+
+	ret = mdm_link_varint_get(&buf[offset], len - offset, &timestamp_delta);
+	if (ret < 0) {
+		return ret;
+	}
+
+	offset += ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(distances); i++) {
+		if (!(buf[0] & BIT(i))) {
+			distances[i] = NAN;
+			continue;
+		}
+
+		if (len - offset < CS_DISTANCE_SIZE) {
+			return -EBADMSG;
+		}
+
+		distances[i] = sign_extend(sys_get_le24(&buf[offset]), 23) / CS_MM_PER_METER;
+		offset += CS_DISTANCE_SIZE;
+	}
+
+	if (offset != len) {
+		return -EBADMSG;
+	}
+
+	cs_msg->type = (buf[0] >> CS_FLAG_TYPE_SHIFT) & CS_FLAG_TYPE_MASK;
+	cs_msg->antenna_path = (buf[0] >> CS_FLAG_AP_SHIFT) & CS_FLAG_AP_MASK;
+	cs_msg->ifft = distances[0];
+	cs_msg->phase_slope = distances[1];
+	cs_msg->rtt = distances[2];
+	cs_msg->timestamp = ctx->frame_time + zigzag_decode(timestamp_delta);
+
+	return 0;
+}
+
+const struct mdm_link_codec cs_distance_link_codec = {
+	.encode = cs_distance_encode,
+	.decode = cs_distance_decode,
+};
@@ -8,6 +8,10 @@
 #include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
 
 #include "channel_sounding.h"
+#include "mdm_link.h"
+#include "mdm_channels.h"
+#include "mdm_cache.h"
+#include "mdm_zbus_log.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(mdm_channel_sounding_module, CONFIG_APP_LOG_LEVEL);
@@ -19,21 +23,19 @@ LOG_MODULE_REGISTER(mdm_channel_sounding_module, CONFIG_APP_LOG_LEVEL);
 /* This file is for the non-runner/controller side: the controller has the shadow channel, and the
  * runner has the main channel
  */
-ZBUS_SHADOW_CHAN_DEFINE(
-	CS_DISTANCE_CHAN,
-	struct cs_distance_msg,
-	MDM_CHANNEL_SOUNDING_PROXY_NODE,
-	NULL,
-	ZBUS_OBSERVERS_EMPTY,
-	ZBUS_MSG_INIT(0)
-);
+MDM_CHANNELS_DEFINE(MDM_CHANNEL_SOUNDING_CHANNELS, CONTROLLER)
+
+#if IS_ENABLED(CONFIG_MDM_CHANNEL_SOUNDING_CACHE)
+MDM_SHADOW_CACHE_DEFINE(cs_distance_cache, CS_DISTANCE_CHAN, struct cs_distance_msg);
+#endif
 
 #if IS_ENABLED(CONFIG_MDM_CHANNEL_SOUNDING_ZBUS_LOGGING)
 
-static void log_cs_message(const struct zbus_channel *chan)
+/* Called in the logging thread */
+static void log_cs_message(const void *message, uint32_t time)
 {
-	const struct cs_distance_msg *msg = zbus_chan_const_msg(chan);
-	LOG_INF("=== Channel Sounding ZBUS Message Received ===");
+	const struct cs_distance_msg *msg = message;
+	LOG_INF("=== Channel Sounding ZBUS Message Received at %u ms ===", time);
 	LOG_INF("Type: %s", cs_message_type_to_string(msg->type));
 	LOG_INF("Timestamp: %u ms", msg->timestamp);
 	LOG_INF("Antenna Path: %u", msg->antenna_path);
@@ -42,7 +44,6 @@ static void log_cs_message(const struct zbus_channel *chan)
 	LOG_INF("=============================================");
 }
 
-ZBUS_LISTENER_DEFINE(cs_logger, log_cs_message);
-ZBUS_CHAN_ADD_OBS(CS_DISTANCE_CHAN, cs_logger, 0);
+MDM_ZBUS_LOG_CHAN_ADD(CS_DISTANCE_CHAN, log_cs_message);
 
 #endif /* CONFIG_MDM_CHANNEL_SOUNDING_ZBUS_LOGGING */
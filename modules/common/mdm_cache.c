@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+
+#include "mdm_cache.h"
+
+void mdm_shadow_cache_update(struct mdm_shadow_cache *cache, const void *msg)
+{
+	/* Update n goes to copy n % 2, which readers of update n - 1 do not use */
+	uint32_t seq = (uint32_t)atomic_inc(&cache->seq) + 1;
+	size_t copy = ((seq + 1) / 2) & 1;
+
+	memcpy(&cache->buf[copy * cache->size], msg, cache->size);
+	cache->rx_time[copy] = k_uptime_get();
+
+	(void)atomic_inc(&cache->seq);
+}
+
+int mdm_shadow_cache_read(const struct mdm_shadow_cache *cache, void *msg,
+			  struct mdm_shadow_cache_info *info)
+{
+	uint32_t updates;
+	int64_t rx_time;
+
+	while (true) {
+		uint32_t start = (uint32_t)atomic_get(&cache->seq);
+		size_t copy;
+
+		/* Completed updates, an update may be in progress on the other copy */
+		updates = start / 2;
+		if (updates == 0) {
+			return -ENODATA;
+		}
+
+		copy = updates & 1;
+
+		memcpy(msg, &cache->buf[copy * cache->size], cache->size);
+		rx_time = cache->rx_time[copy];
+
+		barrier_dmem_fence_full();
+
+		/* The copy is only written again once update updates + 2 has started */
+		if ((uint32_t)atomic_get(&cache->seq) - 2 * updates < 3) {
+			break;
+		}
+	}
+
+	if (info) {
+		info->rx_time = rx_time;
+		info->age_ms = (uint32_t)CLAMP(k_uptime_get() - rx_time, 0, UINT32_MAX);
+		info->updates = updates;
+	}
+
+	return 0;
+}
+
+int mdm_shadow_cache_read_if_fresher_than(const struct mdm_shadow_cache *cache, void *msg,
+					  uint32_t max_age_ms, uint32_t *age_ms)
+{
+	struct mdm_shadow_cache_info info;
+	int err;
+
+	err = mdm_shadow_cache_read(cache, msg, &info);
+	if (err) {
+		return err;
+	}
+
+	if (age_ms) {
+		*age_ms = info.age_ms;
+	}
+
+	return (info.age_ms > max_age_ms) ? -ESTALE : 0;
+}
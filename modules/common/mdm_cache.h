@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Read cache of shadow channels.
+ *
+ * Keeps the latest message of a shadow channel together with the time it was received, so
+ * that polling consumers can read a hot value and check its age without claiming the channel.
+ * The cache is updated by a listener in the receive context of the proxy agent or link.
+ *
+ * The cache holds two copies of the message. An update writes the copy readers are not
+ * reading, and readers only retry if two updates complete while they copy the message, so
+ * a reader never waits for the receive thread, even when it preempted an update.
+ */
+
+#ifndef MDM_CACHE_H__
+#define MDM_CACHE_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct mdm_shadow_cache {
+	/** Two copies of the message */
+	uint8_t *buf;
+
+	/** Uptime in milliseconds when each copy was received */
+	int64_t rx_time[2];
+
+	/** Message size */
+	size_t size;
+
+	/** Incremented before and after every update, odd while an update is in progress */
+	atomic_t seq;
+};
+
+/** Metadata of a cached message */
+struct mdm_shadow_cache_info {
+	/** Uptime in milliseconds when the message was received */
+	int64_t rx_time;
+
+	/** Time since the message was received, in milliseconds */
+	uint32_t age_ms;
+
+	/** Messages received so far */
+	uint32_t updates;
+};
+
+/**
+ * @brief Define a read cache of a channel.
+ *
+ * @param _name Name of the cache.
+ * @param _chan Channel to cache, typically a shadow channel.
+ * @param _type Message type of the channel.
+ */
+#define MDM_SHADOW_CACHE_DEFINE(_name, _chan, _type)						\
+	static _type _CONCAT(_name, _buf)[2];							\
+	struct mdm_shadow_cache _name = {							\
+		.buf = (uint8_t *)_CONCAT(_name, _buf),						\
+		.size = sizeof(_type),								\
+	};											\
+	static void _CONCAT(_name, _update)(const struct zbus_channel *chan)			\
+	{											\
+		mdm_shadow_cache_update(&_name, zbus_chan_const_msg(chan));			\
+	}											\
+	ZBUS_LISTENER_DEFINE(_CONCAT(_name, _listener), _CONCAT(_name, _update));		\
+	ZBUS_CHAN_ADD_OBS(_chan, _CONCAT(_name, _listener), 0)
+
+/** @brief Declare a read cache defined with MDM_SHADOW_CACHE_DEFINE(). */
+#define MDM_SHADOW_CACHE_DECLARE(_name) extern struct mdm_shadow_cache _name
+
+/**
+ * @brief Store a received message in a cache.
+ *
+ * Called by the cache's listener. Calls must be serialized, which the channel does for its
+ * listeners.
+ *
+ * @param cache Cache to update.
+ * @param msg Received message, of the cache's message size.
+ */
+void mdm_shadow_cache_update(struct mdm_shadow_cache *cache, const void *msg);
+
+/**
+ * @brief Read the latest message of a cache.
+ *
+ * Does not block, and can be called from any context.
+ *
+ * @param cache Cache to read.
+ * @param msg Buffer of the cache's message size to copy the message to.
+ * @param info Filled with the message's metadata, or NULL.
+ *
+ * @retval 0 On success.
+ * @retval -ENODATA No message was received yet.
+ */
+int mdm_shadow_cache_read(const struct mdm_shadow_cache *cache, void *msg,
+			  struct mdm_shadow_cache_info *info);
+
+/**
+ * @brief Read the latest message of a cache if it was received recently enough.
+ *
+ * @param cache Cache to read.
+ * @param msg Buffer of the cache's message size to copy the message to. Also written if the
+ *	      message is too old.
+ * @param max_age_ms Largest acceptable time since the message was received, in milliseconds.
+ * @param age_ms Set to the time since the message was received, or NULL.
+ *
+ * @retval 0 On success.
+ * @retval -ENODATA No message was received yet.
+ * @retval -ESTALE The message is older than @p max_age_ms.
+ */
+int mdm_shadow_cache_read_if_fresher_than(const struct mdm_shadow_cache *cache, void *msg,
+					  uint32_t max_age_ms, uint32_t *age_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_CACHE_H__ */
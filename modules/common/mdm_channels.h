@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Compile-time registry of the module channels.
+ *
+ * Every module lists its channels once in its header, as an X-macro taking the entry macro:
+ *
+ *	#define MDM_MY_MODULE_CHANNELS(X)						\
+ *		X(MY_MODULE_CHAN, struct my_module_msg, RUNNER, MDM_MY_MODULE_PROXY_NODE,	\
+ *		  MDM_LINK_ID_MY_MODULE, NULL, MDM_LINK_LANE_DEFAULT, 0)
+ *
+ * with the arguments (channel, message type, owner, node, record identifier, codec, lane,
+ * flags). The owner is RUNNER for channels published by the module runner and CONTROLLER
+ * for channels published by the other domain. The last four arguments are the ones of
+ * MDM_PROXY_ADD_CHAN_WITH_FLAGS() and are only used with CONFIG_MDM_LINK.
+ *
+ * The runner and the other domain both generate their definitions from the same list with
+ * MDM_CHANNELS_DEFINE(), so the two sides cannot disagree on a type or identifier.
+ * MDM_CHANNELS_MSG_SIZE_MAX is the largest message of all modules built into the image.
+ */
+
+#ifndef MDM_CHANNELS_H__
+#define MDM_CHANNELS_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "module_common.h"
+
+#if defined(CONFIG_MDM_LED)
+#include "mdm_led.h"
+#endif
+
+#if defined(CONFIG_MDM_BLE_NUS)
+#include "ble_nus.h"
+#endif
+
+#if defined(CONFIG_MDM_CHANNEL_SOUNDING)
+#include "channel_sounding.h"
+#endif
+
+#if defined(CONFIG_MDM_PROXY_BENCH)
+#include "proxy_bench.h"
+#endif
+
+#if defined(CONFIG_MDM_TIME_SYNC)
+#include "mdm_time.h"
+#endif
+
+#if defined(CONFIG_MDM_STATS)
+#include "mdm_stats.h"
+#endif
+
+#if defined(CONFIG_MDM_HEALTH)
+#include "mdm_health.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define Z_MDM_CHANNELS_IF(_config, _LIST, X) COND_CODE_1(_config, (_LIST(X)), ())
+
+/**
+ * @brief Channels of all modules built into this image.
+ *
+ * @param X Entry macro, called with the arguments of a module channel list entry.
+ */
+#define MDM_CHANNELS(X)										\
+	Z_MDM_CHANNELS_IF(CONFIG_MDM_LED, MDM_LED_CHANNELS, X)					\
+	Z_MDM_CHANNELS_IF(CONFIG_MDM_BLE_NUS, MDM_BLE_NUS_CHANNELS, X)				\
+	Z_MDM_CHANNELS_IF(CONFIG_MDM_CHANNEL_SOUNDING, MDM_CHANNEL_SOUNDING_CHANNELS, X)	\
+	Z_MDM_CHANNELS_IF(CONFIG_MDM_PROXY_BENCH, MDM_PROXY_BENCH_CHANNELS, X)			\
+	Z_MDM_CHANNELS_IF(CONFIG_MDM_TIME_SYNC, MDM_TIME_CHANNELS, X)				\
+	Z_MDM_CHANNELS_IF(CONFIG_MDM_STATS_PUBLISH, MDM_STATS_CHANNELS, X)			\
+	Z_MDM_CHANNELS_IF(CONFIG_MDM_HEALTH, MDM_HEALTH_CHANNELS, X)
+
+/** Size of the largest message of all channels in MDM_CHANNELS() */
+#define MDM_CHANNELS_MSG_SIZE_MAX MAX_MSG_SIZE_FROM_LIST(MDM_CHANNELS)
+
+#if defined(CONFIG_MDM_STATS)
+/* Notified before the observers added with ZBUS_CHAN_ADD_OBS(), so they can be timed */
+#define Z_MDM_CHANNEL_OBSERVERS ZBUS_OBSERVERS(mdm_stats_begin)
+#else
+#define Z_MDM_CHANNEL_OBSERVERS ZBUS_OBSERVERS_EMPTY
+#endif
+
+/* A reliable channel whose messages cannot be kept for retransmission would lose records */
+#define Z_MDM_CHANNEL_RETX_CHECK(_chan, _type, _flags)						\
+	BUILD_ASSERT(!((_flags) & MDM_LINK_CHAN_RELIABLE) || MDM_LINK_RETX_FITS(_type),	\
+		     #_chan " is reliable but larger than CONFIG_MDM_LINK_RETX_SLOT_SIZE")
+
+/* The domain publishing a channel defines it and adds it to the proxy, the other domain
+ * defines its shadow. Each entry is a complete definition, so lists are expanded without a
+ * trailing semicolon.
+ */
+#define Z_MDM_CHANNEL_OWN(_chan, _type, _node, _id, _codec, _lane, _flags)			\
+	ZBUS_CHAN_DEFINE(_chan, _type, NULL, NULL, Z_MDM_CHANNEL_OBSERVERS,			\
+			 ZBUS_MSG_INIT(0));							\
+	Z_MDM_CHANNEL_RETX_CHECK(_chan, _type, _flags);						\
+	MDM_PROXY_ADD_CHAN_WITH_FLAGS(_node, _chan, _id, _codec, _lane, _flags);
+
+#define Z_MDM_CHANNEL_ADD(_chan, _type, _node, _id, _codec, _lane, _flags)			\
+	Z_MDM_CHANNEL_RETX_CHECK(_chan, _type, _flags);						\
+	MDM_PROXY_ADD_CHAN_WITH_FLAGS(_node, _chan, _id, _codec, _lane, _flags);
+
+#define Z_MDM_CHANNEL_SHADOW(_chan, _type, _node, _id, _codec, _lane, _flags)			\
+	MDM_SHADOW_CHAN_DEFINE_WITH_CODEC(_chan, _type, _node, _id, _codec, NULL,		\
+					  Z_MDM_CHANNEL_OBSERVERS, ZBUS_MSG_INIT(0));
+
+#define Z_MDM_CHANNEL_NONE(_chan, _type, _node, _id, _codec, _lane, _flags)
+
+/* Entry macros by side and owner of the channel */
+#define Z_MDM_CHANNEL_DEFINE_RUNNER_RUNNER Z_MDM_CHANNEL_OWN
+#define Z_MDM_CHANNEL_DEFINE_RUNNER_CONTROLLER Z_MDM_CHANNEL_SHADOW
+#define Z_MDM_CHANNEL_DEFINE_CONTROLLER_RUNNER Z_MDM_CHANNEL_SHADOW
+#define Z_MDM_CHANNEL_DEFINE_CONTROLLER_CONTROLLER Z_MDM_CHANNEL_OWN
+#define Z_MDM_CHANNEL_ADD_RUNNER_RUNNER Z_MDM_CHANNEL_ADD
+#define Z_MDM_CHANNEL_ADD_RUNNER_CONTROLLER Z_MDM_CHANNEL_NONE
+#define Z_MDM_CHANNEL_ADD_CONTROLLER_RUNNER Z_MDM_CHANNEL_NONE
+#define Z_MDM_CHANNEL_ADD_CONTROLLER_CONTROLLER Z_MDM_CHANNEL_ADD
+
+#define Z_MDM_CHANNEL_DEFINE_RUNNER(_chan, _type, _owner, ...)				\
+	_CONCAT(Z_MDM_CHANNEL_DEFINE_RUNNER_, _owner)(_chan, _type, __VA_ARGS__)
+#define Z_MDM_CHANNEL_DEFINE_CONTROLLER(_chan, _type, _owner, ...)				\
+	_CONCAT(Z_MDM_CHANNEL_DEFINE_CONTROLLER_, _owner)(_chan, _type, __VA_ARGS__)
+#define Z_MDM_CHANNEL_ADD_RUNNER(_chan, _type, _owner, ...)					\
+	_CONCAT(Z_MDM_CHANNEL_ADD_RUNNER_, _owner)(_chan, _type, __VA_ARGS__)
+#define Z_MDM_CHANNEL_ADD_CONTROLLER(_chan, _type, _owner, ...)				\
+	_CONCAT(Z_MDM_CHANNEL_ADD_CONTROLLER_, _owner)(_chan, _type, __VA_ARGS__)
+
+/**
+ * @brief Define the channels of a module list on one side.
+ *
+ * Channels owned by the side are defined and added to the proxy, the other channels are
+ * defined as shadow channels. Needs mdm_link.h.
+ *
+ * @param _LIST Channel list of the module, such as MDM_LED_CHANNELS.
+ * @param _side RUNNER in the module runner, CONTROLLER in the other domain.
+ */
+#define MDM_CHANNELS_DEFINE(_LIST, _side) _LIST(_CONCAT(Z_MDM_CHANNEL_DEFINE_, _side))
+
+/**
+ * @brief Add the channels of a module list owned by one side to the proxy.
+ *
+ * For channels that are defined elsewhere, such as by an application that already has them.
+ *
+ * @param _LIST Channel list of the module.
+ * @param _side RUNNER in the module runner, CONTROLLER in the other domain.
+ */
+#define MDM_CHANNELS_PROXY_ADD(_LIST, _side) _LIST(_CONCAT(Z_MDM_CHANNEL_ADD_, _side))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_CHANNELS_H__ */
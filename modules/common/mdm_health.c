@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
+
+#include "mdm_health.h"
+#include "mdm_link.h"
+#include "mdm_channels.h"
+#include "mdm_stats.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mdm_health, CONFIG_MDM_HEALTH_LOG_LEVEL);
+
+#ifndef MDM_HEALTH_NODE
+#error "MDM_HEALTH_NODE must be defined to publish health reports"
+#endif
+
+BUILD_ASSERT(sizeof(struct mdm_health_msg) < UINT8_MAX, "Health report too large for a record");
+
+static atomic_t modules_ready;
+static atomic_t modules_failed;
+
+void mdm_health_module_status_set(enum mdm_health_module module, int err)
+{
+	if (err) {
+		(void)atomic_or(&modules_failed, BIT(module));
+	} else {
+		(void)atomic_or(&modules_ready, BIT(module));
+	}
+}
+
+#if defined(CONFIG_MDM_RUNNER_DOMAIN)
+
+/* The runner publishes the reports */
+MDM_CHANNELS_DEFINE(MDM_HEALTH_CHANNELS, RUNNER)
+
+#define HEALTH_PUB_TIMEOUT K_MSEC(100)
+
+#if K_HEAP_MEM_POOL_SIZE > 0
+extern struct k_heap _system_heap;
+#endif
+
+/* Execution cycles of a thread at the previous report */
+struct thread_cycles {
+	const struct k_thread *thread;
+	uint64_t cycles;
+};
+
+struct collect_ctx {
+	struct mdm_health_msg *msg;
+	uint64_t elapsed;
+
+	/* Cycles of the threads in msg, kept for the next report */
+	struct thread_cycles now[CONFIG_MDM_HEALTH_THREADS];
+};
+
+/* Only used by the publishing thread */
+static struct thread_cycles prev[CONFIG_MDM_HEALTH_THREADS];
+static k_thread_runtime_stats_t prev_all;
+
+static uint16_t load_get(uint64_t cycles, uint64_t elapsed)
+{
+	return (elapsed > 0) ? (uint16_t)MIN(cycles * 1000 / elapsed, 1000) : 0;
+}
+
+static uint64_t prev_cycles_get(const struct k_thread *thread)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(prev); i++) {
+		if (prev[i].thread == thread) {
+			return prev[i].cycles;
+		}
+	}
+
+	/* Started since the previous report */
+	return 0;
+}
+
+static void thread_collect(const struct k_thread *cthread, void *user_data)
+{
+	struct collect_ctx *ctx = user_data;
+	struct mdm_health_msg *msg = ctx->msg;
+	struct k_thread *thread = (struct k_thread *)cthread;
+	struct mdm_health_thread *entry;
+	k_thread_runtime_stats_t stats;
+	const char *name;
+	size_t unused = 0;
+
+	if (msg->thread_count == ARRAY_SIZE(msg->threads)) {
+		msg->threads_skipped++;
+		return;
+	}
+
+	entry = &msg->threads[msg->thread_count];
+
+	name = k_thread_name_get(thread);
+	strncpy(entry->name, name ? name : "", sizeof(entry->name));
+
+	if (k_thread_runtime_stats_get(thread, &stats) == 0) {
+		ctx->now[msg->thread_count].thread = thread;
+		ctx->now[msg->thread_count].cycles = stats.execution_cycles;
+		entry->load = load_get(stats.execution_cycles - prev_cycles_get(thread),
+				       ctx->elapsed);
+	}
+
+	/* Scans the stack for the first byte that was written */
+	(void)k_thread_stack_space_get(thread, &unused);
+	entry->stack_size = (uint16_t)MIN(thread->stack_info.size, UINT16_MAX);
+	entry->stack_unused = (uint16_t)MIN(unused, UINT16_MAX);
+
+	msg->thread_count++;
+}
+
+static void heap_collect(struct mdm_health_msg *msg)
+{
+#if K_HEAP_MEM_POOL_SIZE > 0
+	struct sys_memory_stats stats;
+
+	if (sys_heap_runtime_stats_get(&_system_heap.heap, &stats) == 0) {
+		msg->heap_size = K_HEAP_MEM_POOL_SIZE;
+		msg->heap_used = stats.allocated_bytes;
+		msg->heap_max_used = stats.max_allocated_bytes;
+	}
+#else
+	ARG_UNUSED(msg);
+#endif
+}
+
+int mdm_health_publish(struct mdm_health_msg *out)
+{
+	/* Collected outside of the channel, scanning the stacks takes a while */
+	static struct mdm_health_msg msg;
+	static struct collect_ctx ctx;
+	k_thread_runtime_stats_t all;
+	int err;
+
+	(void)k_thread_runtime_stats_all_get(&all);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.uptime_ms = k_uptime_get_32();
+	msg.modules_ready = (uint8_t)atomic_get(&modules_ready);
+	msg.modules_failed = (uint8_t)atomic_get(&modules_failed);
+
+	/* Execution cycles count idle time as well, total cycles do not */
+	msg.cpu_load = load_get(all.total_cycles - prev_all.total_cycles,
+				all.execution_cycles - prev_all.execution_cycles);
+
+	memset(ctx.now, 0, sizeof(ctx.now));
+	ctx.msg = &msg;
+	ctx.elapsed = all.execution_cycles - prev_all.execution_cycles;
+
+	/* Not holding the thread list lock while the stacks are scanned */
+	k_thread_foreach_unlocked(thread_collect, &ctx);
+
+	heap_collect(&msg);
+
+	memcpy(prev, ctx.now, sizeof(prev));
+	prev_all = all;
+
+	if (out) {
+		*out = msg;
+	}
+
+	err = zbus_chan_pub(&MDM_HEALTH_CHAN, &msg, HEALTH_PUB_TIMEOUT);
+	if (err) {
+		LOG_ERR("zbus_chan_pub, error: %d", err);
+		mdm_stats_pub_failed(&MDM_HEALTH_CHAN, err);
+	}
+
+	return err;
+}
+
+#else
+
+/* The controller receives the reports of the runner */
+MDM_CHANNELS_DEFINE(MDM_HEALTH_CHANNELS, CONTROLLER)
+
+int mdm_health_publish(struct mdm_health_msg *msg)
+{
+	ARG_UNUSED(msg);
+
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_MDM_RUNNER_DOMAIN */
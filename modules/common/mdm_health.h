@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Health and load reports of the runner domain.
+ *
+ * The runner periodically publishes a compact report on MDM_HEALTH_CHAN: CPU load and the load
+ * of each thread since the previous report, stack high-water marks, system heap usage and the
+ * init status of the modules. The controller receives it on its shadow of the channel, so
+ * stack and heap sizes can be tuned from real data and CPU saturation spotted remotely.
+ */
+
+#ifndef MDM_HEALTH_H__
+#define MDM_HEALTH_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Channel carrying the reports, owned by the runner */
+ZBUS_CHAN_DECLARE(MDM_HEALTH_CHAN);
+
+/* Channel list, see mdm_channels.h */
+#define MDM_HEALTH_CHANNELS(X)									\
+	X(MDM_HEALTH_CHAN, struct mdm_health_msg, RUNNER, MDM_HEALTH_NODE,			\
+	  MDM_LINK_ID_HEALTH, NULL, MDM_LINK_LANE_DEFAULT, 0)
+
+/** Modules reporting their init status */
+enum mdm_health_module {
+	MDM_HEALTH_MODULE_LED,
+	MDM_HEALTH_MODULE_BLE_NUS,
+	MDM_HEALTH_MODULE_CHANNEL_SOUNDING,
+};
+
+#if defined(CONFIG_MDM_HEALTH)
+
+/** Length of the thread names in a report */
+#define MDM_HEALTH_THREAD_NAME_LEN 8
+
+/** Load and stack use of a thread */
+struct mdm_health_thread {
+	/** Start of the thread name, not terminated if it fills the array */
+	char name[MDM_HEALTH_THREAD_NAME_LEN];
+
+	/** Share of the CPU time since the previous report, in tenths of a percent */
+	uint16_t load;
+
+	/** Stack size in bytes */
+	uint16_t stack_size;
+
+	/** Stack bytes never used since the thread started */
+	uint16_t stack_unused;
+};
+
+/** Message of MDM_HEALTH_CHAN */
+struct mdm_health_msg {
+	/** Runner uptime in milliseconds */
+	uint32_t uptime_ms;
+
+	/** System heap size, bytes in use and most bytes ever in use */
+	uint32_t heap_size;
+	uint32_t heap_used;
+	uint32_t heap_max_used;
+
+	/** Share of non-idle CPU time since the previous report, in tenths of a percent */
+	uint16_t cpu_load;
+
+	/** Bitmasks of the modules that initialized, and that failed to initialize */
+	uint8_t modules_ready;
+	uint8_t modules_failed;
+
+	/** Entries used in @ref threads */
+	uint8_t thread_count;
+
+	/** Threads left out because @ref threads was full */
+	uint8_t threads_skipped;
+
+	struct mdm_health_thread threads[CONFIG_MDM_HEALTH_THREADS];
+};
+
+/**
+ * @brief Report the init status of a module.
+ *
+ * @param module Module that completed its init.
+ * @param err 0 if the module is ready, the init error otherwise.
+ */
+void mdm_health_module_status_set(enum mdm_health_module module, int err);
+
+/**
+ * @brief Collect a report and publish it on MDM_HEALTH_CHAN.
+ *
+ * Loads are measured since the previous call. Only used by the runner domain.
+ *
+ * @param msg Filled with the published report, may be NULL.
+ *
+ * @return 0 on success, negative error code otherwise.
+ */
+int mdm_health_publish(struct mdm_health_msg *msg);
+
+#else
+
+static inline void mdm_health_module_status_set(enum mdm_health_module module, int err)
+{
+	ARG_UNUSED(module);
+	ARG_UNUSED(err);
+}
+
+#endif /* CONFIG_MDM_HEALTH */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_HEALTH_H__ */
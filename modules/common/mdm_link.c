@@ -0,0 +1,1891 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/random/random.h>
+
+#include "mdm_link.h"
+#include "mdm_link_transport.h"
+#include "mdm_stats.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mdm_link, CONFIG_MDM_LINK_LOG_LEVEL);
+
+BUILD_ASSERT(IS_ENABLED(CONFIG_MDM_LINK_PROXY) || IS_ENABLED(CONFIG_MDM_LINK_IPC),
+	     "The multi-domain link needs at least one transport");
+BUILD_ASSERT(offsetof(struct mdm_link_frame, data) == sizeof(struct mdm_link_frame_hdr));
+
+#define LINK_PUB_TIMEOUT K_MSEC(CONFIG_MDM_LINK_PUB_TIMEOUT_MS)
+
+#if defined(CONFIG_MDM_LINK_PROXY)
+struct mdm_link mdm_link_proxy = {
+	.name = "proxy",
+	.send = mdm_link_proxy_send,
+	.config = &mdm_link_proxy_config,
+};
+#endif
+
+#if defined(CONFIG_MDM_LINK_PROXY2)
+struct mdm_link mdm_link_proxy2 = {
+	.name = "proxy2",
+	.send = mdm_link_proxy_send,
+	.config = &mdm_link_proxy2_config,
+};
+#endif
+
+#if defined(CONFIG_MDM_LINK_IPC)
+struct mdm_link mdm_link_ipc = {
+	.name = "ipc",
+	.send = mdm_link_ipc_send,
+};
+#endif
+
+static struct mdm_link *const links[] = {
+#if defined(CONFIG_MDM_LINK_PROXY)
+	&mdm_link_proxy,
+#endif
+#if defined(CONFIG_MDM_LINK_PROXY2)
+	&mdm_link_proxy2,
+#endif
+#if defined(CONFIG_MDM_LINK_IPC)
+	&mdm_link_ipc,
+#endif
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(link_stacks, ARRAY_SIZE(links), CONFIG_MDM_LINK_TX_STACK_SIZE);
+
+static const struct mdm_link_chan *link_chan_find_by_chan(const struct zbus_channel *chan)
+{
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		if (entry->tx && entry->chan == chan) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+#if defined(CONFIG_MDM_LINK_IPC_LOOPBACK)
+/* The loopback hands this domain its own frames. Ids of channels it transmits stand for the
+ * received channels paired with them, and the other way round, see MDM_LINK_LOOPBACK_MIRROR().
+ */
+static uint8_t link_peer_id(const struct mdm_link *link, uint8_t id, bool tx)
+{
+	if (link != &mdm_link_ipc) {
+		return id;
+	}
+
+	STRUCT_SECTION_FOREACH(mdm_link_mirror, mirror) {
+		if (tx && mirror->rx_id == id) {
+			return mirror->tx_id;
+		}
+
+		if (!tx && mirror->tx_id == id) {
+			return mirror->rx_id;
+		}
+	}
+
+	return id;
+}
+#else
+static inline uint8_t link_peer_id(const struct mdm_link *link, uint8_t id, bool tx)
+{
+	return id;
+}
+#endif /* CONFIG_MDM_LINK_IPC_LOOPBACK */
+
+/* Channel of a record identifier received from the other domain, tx selects the channels this
+ * domain transmits, which credit and acknowledgment reports refer to
+ */
+static const struct mdm_link_chan *link_chan_find_by_id(const struct mdm_link *link, uint8_t id,
+							 bool tx)
+{
+	id = link_peer_id(link, id, tx);
+
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		if (entry->tx == tx && entry->link == link && entry->id == id) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Must be called with the link lock held */
+static inline struct mdm_link_frame *fill_frame(struct mdm_link_lane *lane)
+{
+	return &lane->frames[lane->fill];
+}
+
+/* Must be called with the link lock held */
+static inline struct mdm_link_frame *queued_frame(struct mdm_link_lane *lane)
+{
+	return &lane->frames[lane->fill ^ 1];
+}
+
+static inline uint32_t lane_window_ms(const struct mdm_link *link,
+				      const struct mdm_link_lane *lane)
+{
+	if (lane == &link->lanes[0] && CONFIG_MDM_LINK_LANES > 1) {
+		return CONFIG_MDM_LINK_PRIO_WINDOW_MS;
+	}
+
+	return CONFIG_MDM_LINK_WINDOW_MS;
+}
+
+#if defined(CONFIG_MDM_LINK_SUPPRESS_UNCHANGED)
+
+/* Check whether an update is identical to the last message sent on the channel. Must be called
+ * with the link lock held and the channel locked by its publisher.
+ */
+static bool suppress_check(const struct mdm_link_chan *entry, uint32_t crc)
+{
+	struct mdm_link_chan_state *state = entry->state;
+
+	if (state->last_valid && state->last_crc == crc) {
+		state->suppressed++;
+		return true;
+	}
+
+	return false;
+}
+
+/* Remember the message of an update once its record is added, err being the result of adding
+ * it. An update left for later is sent with the channel's message at that time, which is not
+ * known yet. An update that cannot be encoded leaves the other domain's copy unchanged. Must be
+ * called with the link lock held.
+ */
+static void suppress_update(const struct mdm_link_chan *entry, uint32_t crc, int err)
+{
+	struct mdm_link_chan_state *state = entry->state;
+
+	if (err == 0) {
+		state->last_crc = crc;
+		state->last_valid = true;
+	} else if (err == -EAGAIN || err == -ENOBUFS) {
+		state->last_valid = false;
+	}
+}
+
+/* Forget the messages sent on a link, so the next update of every channel is sent. Must be
+ * called with the link lock held.
+ */
+static void suppress_invalidate(struct mdm_link *link)
+{
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		if (entry->tx && entry->link == link) {
+			entry->state->last_valid = false;
+		}
+	}
+}
+
+#else
+
+static inline bool suppress_check(const struct mdm_link_chan *entry, uint32_t crc)
+{
+	return false;
+}
+
+static inline void suppress_update(const struct mdm_link_chan *entry, uint32_t crc, int err)
+{
+}
+
+static inline void suppress_invalidate(struct mdm_link *link)
+{
+}
+
+#endif /* CONFIG_MDM_LINK_SUPPRESS_UNCHANGED */
+
+/* True on the link's sender thread, the only thread that waits for frames to be sent */
+static inline bool link_on_sender(struct mdm_link *link)
+{
+	return k_current_get() == k_work_queue_thread_get(&link->workq);
+}
+
+/* Make the collecting frame of a lane the queued frame. Must be called with the link lock held,
+ * the queued frame must be empty.
+ */
+static inline void lane_swap(struct mdm_link_lane *lane)
+{
+	lane->fill ^= 1;
+	lane->queued_at = k_cycle_get_32();
+	lane->ready = false;
+}
+
+/* Send queued frames, highest priority lane first, until none are left. Returns without
+ * sending if another thread is already sending before the timeout, since that thread also
+ * picks up the frames queued in the meantime.
+ */
+static int link_drain(struct mdm_link *link, k_timeout_t timeout)
+{
+	int ret = 0;
+
+	if (k_mutex_lock(&link->send_lock, timeout)) {
+		return 0;
+	}
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	while (true) {
+		struct mdm_link_lane *lane = NULL;
+		struct mdm_link_frame *frame;
+		uint32_t wait_us;
+		int err;
+
+		for (size_t i = 0; i < ARRAY_SIZE(link->lanes); i++) {
+			struct mdm_link_lane *candidate = &link->lanes[i];
+
+			/* A frame completed while the previous one was being sent */
+			if (candidate->ready && queued_frame(candidate)->hdr.len == 0) {
+				lane_swap(candidate);
+			}
+
+			if (queued_frame(candidate)->hdr.len) {
+				lane = candidate;
+				break;
+			}
+		}
+
+		if (!lane) {
+			break;
+		}
+
+		frame = queued_frame(lane);
+
+		wait_us = k_cyc_to_us_floor32(k_cycle_get_32() - lane->queued_at);
+		lane->stats.frames++;
+		lane->stats.wait_us_total += wait_us;
+		lane->stats.wait_us_max = MAX(lane->stats.wait_us_max, wait_us);
+
+		/* The lane does not swap buffers while its queued frame is not empty, so the
+		 * frame can be sent without holding the link lock.
+		 */
+		k_mutex_unlock(&link->lock);
+
+		err = link->send(link, frame);
+
+		if (err) {
+			LOG_ERR("Cannot send frame on the %s link, error: %d, dropping %u bytes",
+				link->name, err, frame->hdr.len);
+			ret = err;
+		}
+
+		k_mutex_lock(&link->lock, K_FOREVER);
+
+		if (err) {
+			suppress_invalidate(link);
+		}
+
+		lane->stats.depth -= lane->records[lane->fill ^ 1];
+		lane->records[lane->fill ^ 1] = 0;
+		frame->hdr.len = 0;
+	}
+
+	/* Released with the link lock held, so a frame queued after the last check above is
+	 * either seen by this loop or sent by the thread that queued it.
+	 */
+	k_mutex_unlock(&link->send_lock);
+	k_mutex_unlock(&link->lock);
+
+	return ret;
+}
+
+/* Queue the collecting frame of a lane for sending. Must be called with the link lock held. While
+ * the lane's previous frame is being sent, the link's sender thread releases the lock and sends
+ * it, other threads only mark the frame ready for the sender and get false. The caller has the
+ * frame sent with link_kick() or link_drain() after releasing the link lock.
+ */
+static bool lane_queue(struct mdm_link *link, struct mdm_link_lane *lane)
+{
+	if (fill_frame(lane)->hdr.len == 0) {
+		return true;
+	}
+
+	(void)k_work_cancel_delayable(&lane->flush_work);
+
+	while (fill_frame(lane)->hdr.len && queued_frame(lane)->hdr.len) {
+		if (!link_on_sender(link)) {
+			lane->ready = true;
+			return false;
+		}
+
+		k_mutex_unlock(&link->lock);
+		(void)link_drain(link, K_FOREVER);
+		k_mutex_lock(&link->lock, K_FOREVER);
+	}
+
+	/* The sender may have queued the frame while the lock was released */
+	if (fill_frame(lane)->hdr.len) {
+		lane_swap(lane);
+	}
+
+	return true;
+}
+
+/* Have the link's sender thread send the queued frames */
+static inline void link_kick(struct mdm_link *link)
+{
+	(void)k_work_submit_to_queue(&link->workq, &link->tx_work);
+}
+
+/* Runs on the link's sender thread */
+static void flush_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct mdm_link_lane *lane = CONTAINER_OF(dwork, struct mdm_link_lane, flush_work);
+	struct mdm_link *link = lane->link;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+	(void)lane_queue(link, lane);
+	k_mutex_unlock(&link->lock);
+
+	(void)link_drain(link, K_NO_WAIT);
+}
+
+int mdm_link_flush(void)
+{
+	int ret = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(links); i++) {
+		struct mdm_link *link = links[i];
+		int err;
+
+		k_mutex_lock(&link->lock, K_FOREVER);
+
+		for (size_t j = 0; j < ARRAY_SIZE(link->lanes); j++) {
+			(void)lane_queue(link, &link->lanes[j]);
+		}
+
+		k_mutex_unlock(&link->lock);
+
+		err = link_drain(link, K_FOREVER);
+		if (err && !ret) {
+			ret = err;
+		}
+	}
+
+	return ret;
+}
+
+int mdm_link_chan_suppressed_get(const struct zbus_channel *chan, uint32_t *suppressed)
+{
+	const struct mdm_link_chan *entry = link_chan_find_by_chan(chan);
+
+	if (!entry) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&entry->link->lock, K_FOREVER);
+	*suppressed = entry->state->suppressed;
+	k_mutex_unlock(&entry->link->lock);
+
+	return 0;
+}
+
+int mdm_link_chan_stats_get(const struct zbus_channel *chan, struct mdm_link_chan_stats *stats)
+{
+	/* Shadow channels are received, so both directions are searched */
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		if (entry->chan != chan) {
+			continue;
+		}
+
+		k_mutex_lock(&entry->link->lock, K_FOREVER);
+		stats->tx = entry->tx;
+		stats->records = entry->state->records;
+		stats->errors = entry->state->errors;
+		stats->suppressed = entry->state->suppressed;
+		k_mutex_unlock(&entry->link->lock);
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+int mdm_link_lane_stats_get(struct mdm_link *link, uint8_t lane,
+			    struct mdm_link_lane_stats *stats)
+{
+	if (lane >= ARRAY_SIZE(link->lanes)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+	*stats = link->lanes[lane].stats;
+	k_mutex_unlock(&link->lock);
+
+	return 0;
+}
+
+/* Encode a message of a channel. Must be called with the link lock held. Returns the payload
+ * length or a negative error.
+ */
+static int record_encode(const struct mdm_link_chan *entry, const void *msg,
+			 const struct mdm_link_frame *frame, uint8_t *buf, size_t size)
+{
+	size_t msg_size = zbus_chan_msg_size(entry->chan);
+	const struct mdm_link_codec_ctx ctx = {
+		.frame_time = frame->hdr.time,
+	};
+
+	if (entry->codec) {
+		return entry->codec->encode(msg, buf, MIN(size, UINT8_MAX), &ctx);
+	}
+
+	if (msg_size > MIN(size, UINT8_MAX)) {
+		return -EMSGSIZE;
+	}
+
+	memcpy(buf, msg, msg_size);
+
+	return msg_size;
+}
+
+/* Get a lane frame with room for a record of up to size payload bytes. Must be called with the
+ * link lock held. Sets queued if a full frame had to be queued. Returns NULL if both frames of
+ * the lane are full, which only the link's sender thread waits for.
+ */
+static struct mdm_link_frame *lane_reserve(struct mdm_link *link, struct mdm_link_lane *lane,
+					   size_t size, bool *queued)
+{
+	struct mdm_link_frame *frame = fill_frame(lane);
+
+	if (frame->hdr.len + sizeof(struct mdm_link_record_hdr) + size > sizeof(frame->data)) {
+		*queued = true;
+
+		if (!lane_queue(link, lane)) {
+			return NULL;
+		}
+
+		frame = fill_frame(lane);
+	}
+
+	if (frame->hdr.len == 0) {
+		frame->hdr.time = k_uptime_get_32();
+	}
+
+	return frame;
+}
+
+/* Complete a record whose payload was written after the record header position of a frame from
+ * lane_reserve(). Must be called with the link lock held. Returns true if the frame was queued.
+ */
+static bool lane_record_commit(struct mdm_link *link, struct mdm_link_lane *lane, uint8_t id,
+			       uint8_t len, bool urgent)
+{
+	struct mdm_link_frame *frame = fill_frame(lane);
+	struct mdm_link_record_hdr hdr = {
+		.id = id,
+		.len = len,
+	};
+	uint32_t window_ms = lane_window_ms(link, lane);
+
+	memcpy(&frame->data[frame->hdr.len], &hdr, sizeof(hdr));
+	frame->hdr.len += sizeof(hdr) + len;
+
+	lane->records[lane->fill]++;
+	lane->stats.depth++;
+	lane->stats.max_depth = MAX(lane->stats.max_depth, lane->stats.depth);
+
+	if (urgent || window_ms == 0 || frame->hdr.len == sizeof(frame->data)) {
+		(void)lane_queue(link, lane);
+		return true;
+	}
+
+	/* The window starts with the first pending record and is not extended by later records,
+	 * so a steady stream of updates cannot hold back the frame.
+	 */
+	(void)k_work_schedule_for_queue(&link->workq, &lane->flush_work, K_MSEC(window_ms));
+
+	return false;
+}
+
+/* Add a record with a message of a channel, preceded by a sequence number if seq is not
+ * negative. Must be called with the link lock held. Sets queued to true if a frame was queued.
+ * Returns 0 if the record was added or is kept for retransmission, -ENOBUFS if the channel's
+ * latest message is added once the lane has room, or the encoding error.
+ */
+static int record_put(struct mdm_link *link, const struct mdm_link_chan *entry, const void *msg,
+		      int seq, bool *queued)
+{
+	struct mdm_link_lane *lane = &link->lanes[entry->lane];
+	size_t prefix = (seq < 0) ? 0 : 1;
+	struct mdm_link_frame *frame;
+	size_t offset;
+	int len;
+
+	/* Make room for a record of the full message size, which no encoding should exceed */
+	frame = lane_reserve(link, lane, zbus_chan_msg_size(entry->chan) + prefix, queued);
+	if (!frame) {
+		/* Records of reliable channels are already kept and are retransmitted instead */
+		if (seq >= 0) {
+			return 0;
+		}
+
+		/* The sender thread adds the channel's latest message once the lane has room */
+		entry->state->deferred = true;
+		link->deferred = true;
+		return -ENOBUFS;
+	}
+
+	offset = frame->hdr.len + sizeof(struct mdm_link_record_hdr);
+
+	if (prefix) {
+		frame->data[offset] = (uint8_t)seq;
+	}
+
+	len = record_encode(entry, msg, frame, &frame->data[offset + prefix],
+			    MIN(sizeof(frame->data) - offset, UINT8_MAX) - prefix);
+	if (len < 0) {
+		LOG_ERR("Cannot encode %s for the link, error: %d", zbus_chan_name(entry->chan),
+			len);
+		entry->state->errors++;
+		return len;
+	}
+
+	if (lane_record_commit(link, lane, prefix ? (entry->id | MDM_LINK_ID_SEQ) : entry->id,
+			       len + prefix, false)) {
+		*queued = true;
+	}
+
+	return 0;
+}
+
+/* Add a control record to a lane. Must be called with the link lock held. */
+static void ctrl_record_add(struct mdm_link *link, struct mdm_link_lane *lane,
+			    const uint8_t *payload, size_t len, bool urgent)
+{
+	struct mdm_link_frame *frame;
+	bool queued = false;
+
+	frame = lane_reserve(link, lane, len, &queued);
+	if (!frame) {
+		/* Control records are only added on the sender thread, which waits for room */
+		return;
+	}
+
+	memcpy(&frame->data[frame->hdr.len + sizeof(struct mdm_link_record_hdr)], payload, len);
+
+	(void)lane_record_commit(link, lane, MDM_LINK_ID_CONTROL, len, urgent);
+}
+
+/* Send a control record on the highest priority lane without waiting for the batching window.
+ * Must be called with the link lock held, on the link's sender thread. The caller drains the
+ * link after releasing the lock.
+ */
+static void ctrl_add(struct mdm_link *link, const uint8_t *payload, size_t len)
+{
+	ctrl_record_add(link, &link->lanes[0], payload, len, true);
+}
+
+#if defined(CONFIG_MDM_LINK_RELIABLE)
+
+BUILD_ASSERT(CONFIG_MDM_LINK_RETX_WINDOW < INT8_MAX / 2);
+
+/* Acknowledgment: type byte followed by (id, next expected sequence number, nack) entries */
+#define SEQ_ACK_ENTRY_SIZE 3
+#define SEQ_ACK_MAX 16
+
+BUILD_ASSERT(1 + SEQ_ACK_MAX * SEQ_ACK_ENTRY_SIZE <= MDM_LINK_CTRL_SIZE_MAX);
+
+/* Skip: type byte followed by (id, next sequence number the sender can provide) */
+#define SEQ_SKIP_SIZE 3
+
+static inline bool chan_reliable(const struct mdm_link_chan *entry)
+{
+	return entry->flags & MDM_LINK_CHAN_RELIABLE;
+}
+
+/* Must be called with the link lock held */
+static struct mdm_link_retx_slot *retx_slot_find(struct mdm_link *link,
+						 const struct mdm_link_chan *entry, uint8_t seq)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(link->retx); i++) {
+		if (link->retx[i].entry == entry && link->retx[i].seq == seq) {
+			return &link->retx[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Oldest unacknowledged sequence number of a channel, or the next one if all were acknowledged.
+ * Must be called with the link lock held.
+ */
+static uint8_t retx_oldest(struct mdm_link *link, const struct mdm_link_chan *entry)
+{
+	uint8_t oldest = entry->state->seq;
+
+	for (size_t i = 0; i < ARRAY_SIZE(link->retx); i++) {
+		if (link->retx[i].entry == entry && (int8_t)(link->retx[i].seq - oldest) < 0) {
+			oldest = link->retx[i].seq;
+		}
+	}
+
+	return oldest;
+}
+
+/* Keep a copy of the channel's current message until the other domain acknowledges it. Must be
+ * called with the link lock held and the channel locked. Returns the record's sequence number.
+ */
+static uint8_t retx_store(struct mdm_link *link, const struct mdm_link_chan *entry)
+{
+	const struct zbus_channel *chan = entry->chan;
+	struct mdm_link_retx_slot *slot = NULL;
+	uint8_t seq = entry->state->seq++;
+	size_t in_flight = 0;
+
+	if (zbus_chan_msg_size(chan) > CONFIG_MDM_LINK_RETX_SLOT_SIZE) {
+		LOG_WRN("%s is too large to be retransmitted", zbus_chan_name(chan));
+		return seq;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(link->retx); i++) {
+		struct mdm_link_retx_slot *s = &link->retx[i];
+
+		if (!s->entry) {
+			slot = slot ? slot : s;
+		} else if (s->entry == entry) {
+			in_flight++;
+		}
+	}
+
+	/* A full window gives up the oldest record of the channel, a full buffer the record sent
+	 * longest ago
+	 */
+	if (in_flight >= CONFIG_MDM_LINK_RETX_WINDOW) {
+		slot = retx_slot_find(link, entry, retx_oldest(link, entry));
+		link->retx_stats.abandoned++;
+	} else if (!slot) {
+		slot = &link->retx[0];
+
+		for (size_t i = 1; i < ARRAY_SIZE(link->retx); i++) {
+			if ((int32_t)(link->retx[i].sent_at - slot->sent_at) < 0) {
+				slot = &link->retx[i];
+			}
+		}
+
+		link->retx_stats.abandoned++;
+	}
+
+	slot->entry = entry;
+	slot->seq = seq;
+	slot->tries = 0;
+	slot->sent_at = k_uptime_get_32();
+	memcpy(slot->msg, zbus_chan_const_msg(chan), zbus_chan_msg_size(chan));
+
+	if (!k_work_delayable_is_pending(&link->retx_work)) {
+		(void)k_work_schedule_for_queue(&link->workq, &link->retx_work,
+						K_MSEC(CONFIG_MDM_LINK_RETX_TIMEOUT_MS));
+	}
+
+	return seq;
+}
+
+/* Send the unacknowledged records of a channel again, starting at sequence number from. Must be
+ * called with the link lock held, on the link's sender thread. Returns true if a frame was queued.
+ */
+static bool retx_resend(struct mdm_link *link, const struct mdm_link_chan *entry, uint8_t from)
+{
+	uint8_t msg[CONFIG_MDM_LINK_RETX_SLOT_SIZE] __aligned(8);
+	uint32_t now = k_uptime_get_32();
+	bool queued = false;
+
+	for (uint8_t seq = from; seq != entry->state->seq; seq++) {
+		struct mdm_link_retx_slot *slot = retx_slot_find(link, entry, seq);
+
+		if (!slot) {
+			continue;
+		}
+
+		/* record_put() releases the link lock while a full frame is sent, in which time
+		 * the slot can be acknowledged and given to another record. The record is sent
+		 * from a copy and its slot is looked up again.
+		 */
+		memcpy(msg, slot->msg, zbus_chan_msg_size(entry->chan));
+
+		(void)record_put(link, entry, msg, seq, &queued);
+		link->retx_stats.retransmits++;
+
+		slot = retx_slot_find(link, entry, seq);
+		if (slot) {
+			slot->sent_at = now;
+			slot->tries++;
+		}
+	}
+
+	return queued;
+}
+
+/* Handle an acknowledgment from the other domain. Must be called with the link lock held. */
+static void retx_ack(struct mdm_link *link, const struct mdm_link_chan *entry, uint8_t next,
+		     bool nack)
+{
+	uint32_t due = k_uptime_get_32() - CONFIG_MDM_LINK_RETX_TIMEOUT_MS;
+	uint8_t oldest;
+
+	for (size_t i = 0; i < ARRAY_SIZE(link->retx); i++) {
+		struct mdm_link_retx_slot *slot = &link->retx[i];
+
+		if (slot->entry == entry && (int8_t)(slot->seq - next) < 0) {
+			slot->entry = NULL;
+		}
+	}
+
+	if (!nack) {
+		return;
+	}
+
+	/* Records the other domain misses but that were given up are skipped, so that it accepts
+	 * the records that can still be sent
+	 */
+	oldest = retx_oldest(link, entry);
+
+	if ((int8_t)(oldest - next) > 0) {
+		entry->state->skip_due = true;
+	}
+
+	/* The skip and the records are sent by the link's sender thread, so that the receive path
+	 * never waits for a frame to be sent
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(link->retx); i++) {
+		if (link->retx[i].entry == entry) {
+			link->retx[i].sent_at = due;
+		}
+	}
+
+	(void)k_work_reschedule_for_queue(&link->workq, &link->retx_work, K_NO_WAIT);
+}
+
+/* Handle acknowledgments from the other domain */
+static void retx_ack_receive(struct mdm_link *link, const uint8_t *data, size_t len)
+{
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	for (size_t offset = 0; offset + SEQ_ACK_ENTRY_SIZE <= len;
+	     offset += SEQ_ACK_ENTRY_SIZE) {
+		const struct mdm_link_chan *entry = link_chan_find_by_id(link, data[offset], true);
+
+		if (entry) {
+			retx_ack(link, entry, data[offset + 1], data[offset + 2]);
+		}
+	}
+
+	k_mutex_unlock(&link->lock);
+
+	link_kick(link);
+}
+
+/* Accept the records the other domain gave up on */
+static void retx_skip_receive(struct mdm_link *link, const uint8_t *data, size_t len)
+{
+	const struct mdm_link_chan *entry;
+	struct mdm_link_chan_state *state;
+	int8_t skipped;
+
+	if (len < SEQ_SKIP_SIZE - 1) {
+		return;
+	}
+
+	entry = link_chan_find_by_id(link, data[0], false);
+	if (!entry) {
+		return;
+	}
+
+	state = entry->state;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	skipped = (int8_t)(data[1] - state->seq);
+	if (skipped > 0) {
+		LOG_WRN("%s lost %d records on the %s link", zbus_chan_name(entry->chan), skipped,
+			link->name);
+		link->retx_stats.skipped += skipped;
+
+		/* The skipped records will not be published, keep the credit count in step */
+		state->count += skipped;
+		state->seq = data[1];
+		state->nacked = false;
+	}
+
+	k_mutex_unlock(&link->lock);
+}
+
+/* Check the sequence number of a record received on a reliable channel. Returns true if the
+ * record is the next one expected and is to be published.
+ */
+static bool retx_accept(struct mdm_link *link, const struct mdm_link_chan *entry, uint8_t seq)
+{
+	struct mdm_link_chan_state *state = entry->state;
+	int8_t diff;
+	bool accept = false;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	diff = (int8_t)(seq - state->seq);
+
+	if (diff == 0) {
+		state->seq++;
+		state->nacked = false;
+		accept = true;
+	} else if (diff < -2 * CONFIG_MDM_LINK_RETX_WINDOW) {
+		/* Too old to be a retransmission, the other domain restarted */
+		state->seq = seq + 1;
+		state->nacked = false;
+		accept = true;
+	} else if (diff < 0) {
+		/* A retransmission of a record whose acknowledgment was lost */
+		link->retx_stats.duplicates++;
+		state->ack_due = true;
+	} else if (!state->nacked) {
+		/* Records after a gap are discarded until the missing ones are retransmitted, so
+		 * the channel is never published out of order
+		 */
+		link->retx_stats.lost += diff;
+		state->nacked = true;
+		state->ack_due = true;
+	}
+
+	if (accept) {
+		state->ack_due = true;
+	}
+
+	k_mutex_unlock(&link->lock);
+
+	return accept;
+}
+
+/* Acknowledge the records received on reliable channels, and ask for the missing ones. Runs on
+ * the link's sender thread.
+ */
+static void retx_ack_report(struct mdm_link *link)
+{
+	uint8_t report[1 + SEQ_ACK_MAX * SEQ_ACK_ENTRY_SIZE];
+	size_t len = 1;
+
+	report[0] = MDM_LINK_CTRL_SEQ_ACK;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		struct mdm_link_chan_state *state = entry->state;
+
+		if (entry->tx || entry->link != link || !state->ack_due) {
+			continue;
+		}
+
+		if (len + SEQ_ACK_ENTRY_SIZE > sizeof(report)) {
+			break;
+		}
+
+		report[len] = entry->id;
+		report[len + 1] = state->seq;
+		report[len + 2] = state->nacked;
+		len += SEQ_ACK_ENTRY_SIZE;
+
+		state->ack_due = false;
+	}
+
+	if (len > 1) {
+		ctrl_add(link, report, len);
+	}
+
+	k_mutex_unlock(&link->lock);
+}
+
+/* Runs on the link's sender thread while records wait for an acknowledgment */
+static void retx_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct mdm_link *link = CONTAINER_OF(dwork, struct mdm_link, retx_work);
+	uint32_t now = k_uptime_get_32();
+	bool pending = false;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	/* Ahead of the records, so the other domain accepts them */
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		if (entry->tx && entry->link == link && entry->state->skip_due) {
+			uint8_t skip[SEQ_SKIP_SIZE] = { MDM_LINK_CTRL_SEQ_SKIP, entry->id,
+							retx_oldest(link, entry) };
+
+			entry->state->skip_due = false;
+			ctrl_add(link, skip, sizeof(skip));
+		}
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(link->retx); i++) {
+		struct mdm_link_retx_slot *slot = &link->retx[i];
+
+		if (!slot->entry || now - slot->sent_at < CONFIG_MDM_LINK_RETX_TIMEOUT_MS) {
+			pending |= (slot->entry != NULL);
+			continue;
+		}
+
+		if (slot->tries >= CONFIG_MDM_LINK_RETX_MAX_TRIES) {
+			slot->entry = NULL;
+			link->retx_stats.abandoned++;
+			continue;
+		}
+
+		/* Neither the record nor its acknowledgment arrived, the records of the channel
+		 * after it were discarded by the other domain, so all of them are sent again
+		 */
+		(void)retx_resend(link, slot->entry, retx_oldest(link, slot->entry));
+		pending = true;
+	}
+
+	k_mutex_unlock(&link->lock);
+
+	(void)link_drain(link, K_NO_WAIT);
+
+	if (pending) {
+		(void)k_work_schedule_for_queue(&link->workq, &link->retx_work,
+						K_MSEC(CONFIG_MDM_LINK_RETX_TIMEOUT_MS));
+	}
+}
+
+/* Forget the sequence numbers of a link after the other domain restarted. Must be called with
+ * the link lock held.
+ */
+static void retx_reset(struct mdm_link *link)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(link->retx); i++) {
+		link->retx[i].entry = NULL;
+	}
+
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		if (entry->link == link) {
+			entry->state->seq = 0;
+			entry->state->nacked = false;
+			entry->state->ack_due = false;
+			entry->state->skip_due = false;
+		}
+	}
+}
+
+#else
+
+static inline bool chan_reliable(const struct mdm_link_chan *entry)
+{
+	return false;
+}
+
+static inline uint8_t retx_store(struct mdm_link *link, const struct mdm_link_chan *entry)
+{
+	return 0;
+}
+
+static inline void retx_ack_receive(struct mdm_link *link, const uint8_t *data, size_t len)
+{
+}
+
+static inline void retx_skip_receive(struct mdm_link *link, const uint8_t *data, size_t len)
+{
+}
+
+static inline bool retx_accept(struct mdm_link *link, const struct mdm_link_chan *entry,
+			       uint8_t seq)
+{
+	return false;
+}
+
+static inline void retx_ack_report(struct mdm_link *link)
+{
+}
+
+static inline void retx_reset(struct mdm_link *link)
+{
+}
+
+#endif /* CONFIG_MDM_LINK_RELIABLE */
+
+int mdm_link_retx_stats_get(struct mdm_link *link, struct mdm_link_retx_stats *stats)
+{
+	k_mutex_lock(&link->lock, K_FOREVER);
+	*stats = link->retx_stats;
+	k_mutex_unlock(&link->lock);
+
+	return 0;
+}
+
+/* Add a record with the channel's current message. Must be called with the link lock held and
+ * the channel locked by its publisher or claimed. Sets queued to true if a frame was queued.
+ * Returns the result of record_put().
+ */
+static int record_add(struct mdm_link *link, const struct mdm_link_chan *entry, bool *queued)
+{
+	int seq = chan_reliable(entry) ? retx_store(link, entry) : -1;
+
+	entry->state->records++;
+
+	return record_put(link, entry, zbus_chan_const_msg(entry->chan), seq, queued);
+}
+
+#if defined(CONFIG_MDM_LINK_FLOW_CONTROL)
+
+BUILD_ASSERT(CONFIG_MDM_LINK_CREDITS < UINT16_MAX / 2);
+
+/* Credit report: type byte followed by (id, LE16 count) pairs */
+#define CREDIT_ENTRY_SIZE 3
+#define CREDIT_REPORT_MAX 16
+
+BUILD_ASSERT(1 + CREDIT_REPORT_MAX * CREDIT_ENTRY_SIZE <= MDM_LINK_CTRL_SIZE_MAX);
+
+static inline bool flow_has_credit(const struct mdm_link_chan_state *state)
+{
+	return (uint16_t)(state->count - state->acked) < CONFIG_MDM_LINK_CREDITS;
+}
+
+/* Take a credit for an update of a channel owned by this domain. Must be called with the link
+ * lock held. Returns false if the update has to wait for credits.
+ */
+static bool flow_credit_take(struct mdm_link *link, const struct mdm_link_chan *entry)
+{
+	struct mdm_link_chan_state *state = entry->state;
+	uint32_t now = k_uptime_get_32();
+
+	if (!flow_has_credit(state)) {
+		if (!state->parked) {
+			state->parked = true;
+			state->blocked_since = now;
+
+			/* The window is otherwise only reset by the next publish */
+			(void)k_work_schedule_for_queue(&link->workq, &link->credit_work,
+							K_MSEC(CONFIG_MDM_LINK_CREDIT_TIMEOUT_MS));
+			return false;
+		}
+
+		if (now - state->blocked_since < CONFIG_MDM_LINK_CREDIT_TIMEOUT_MS) {
+			/* The channel only holds its latest message, the parked update is lost */
+			link->flow.dropped++;
+			return false;
+		}
+
+		/* No credits came back, assume the reports or the frames they covered were lost.
+		 * The other domain never counts lost records, so they stay added to its reports.
+		 */
+		LOG_WRN("No credits for %s on the %s link, resetting its window",
+			zbus_chan_name(entry->chan), link->name);
+		link->flow.resyncs++;
+		state->lost += state->count - state->acked;
+		state->acked = state->count;
+	}
+
+	state->parked = false;
+	state->count++;
+
+	return true;
+}
+
+int mdm_link_tx_ready_count(const struct zbus_channel *chan, uint16_t count)
+{
+	const struct mdm_link_chan *entry = link_chan_find_by_chan(chan);
+	struct mdm_link *link;
+	uint16_t in_flight;
+	int ret = 0;
+
+	if (!entry) {
+		return 0;
+	}
+
+	if (count > CONFIG_MDM_LINK_CREDITS) {
+		return -EMSGSIZE;
+	}
+
+	link = entry->link;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	in_flight = entry->state->count - entry->state->acked;
+
+	if (entry->state->parked || in_flight > CONFIG_MDM_LINK_CREDITS - count) {
+		link->flow.throttled++;
+		ret = -EAGAIN;
+	}
+
+	k_mutex_unlock(&link->lock);
+
+	return ret;
+}
+
+/* Send the parked update of a channel that got credits back */
+static void flow_resume(struct mdm_link *link, const struct mdm_link_chan *entry)
+{
+	bool queued = false;
+
+	/* Lock order is channel, then link, same as in the publisher's context */
+	if (zbus_chan_claim(entry->chan, LINK_PUB_TIMEOUT)) {
+		return;
+	}
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	if (entry->state->parked && flow_credit_take(link, entry)) {
+		(void)record_add(link, entry, &queued);
+	}
+
+	k_mutex_unlock(&link->lock);
+
+	(void)zbus_chan_finish(entry->chan);
+
+	if (queued) {
+		link_kick(link);
+	}
+}
+
+/* Runs on the link's sender thread while channels wait for credits */
+static void credit_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct mdm_link *link = CONTAINER_OF(dwork, struct mdm_link, credit_work);
+	uint32_t next = CONFIG_MDM_LINK_CREDIT_TIMEOUT_MS;
+	bool pending = false;
+
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		uint32_t waited;
+		bool parked;
+
+		if (!entry->tx || entry->link != link) {
+			continue;
+		}
+
+		k_mutex_lock(&link->lock, K_FOREVER);
+		parked = entry->state->parked;
+		waited = k_uptime_get_32() - entry->state->blocked_since;
+		k_mutex_unlock(&link->lock);
+
+		if (!parked) {
+			continue;
+		}
+
+		if (waited < CONFIG_MDM_LINK_CREDIT_TIMEOUT_MS) {
+			next = MIN(next, CONFIG_MDM_LINK_CREDIT_TIMEOUT_MS - waited);
+			pending = true;
+			continue;
+		}
+
+		/* Resets the window, a channel that could not be claimed is retried later */
+		flow_resume(link, entry);
+
+		k_mutex_lock(&link->lock, K_FOREVER);
+		pending |= entry->state->parked;
+		k_mutex_unlock(&link->lock);
+	}
+
+	if (pending) {
+		(void)k_work_schedule_for_queue(&link->workq, &link->credit_work, K_MSEC(next));
+	}
+}
+
+/* Handle a credit report from the other domain */
+static void flow_credit_receive(struct mdm_link *link, const uint8_t *data, size_t len)
+{
+	for (size_t offset = 0; offset + CREDIT_ENTRY_SIZE <= len; offset += CREDIT_ENTRY_SIZE) {
+		const struct mdm_link_chan *entry = link_chan_find_by_id(link, data[offset], true);
+		struct mdm_link_chan_state *state;
+		uint16_t reported;
+		uint16_t acked;
+		bool resume;
+
+		if (!entry) {
+			continue;
+		}
+
+		state = entry->state;
+		reported = sys_get_le16(&data[offset + 1]);
+
+		k_mutex_lock(&link->lock, K_FOREVER);
+
+		/* A report older than the latest one would reopen records already accounted for */
+		if ((int16_t)(reported - state->reported) < 0) {
+			k_mutex_unlock(&link->lock);
+			continue;
+		}
+
+		state->reported = reported;
+		acked = reported + state->lost;
+
+		/* Records given up at a window reset may have arrived after all */
+		if ((int16_t)(state->count - acked) < 0) {
+			state->lost -= acked - state->count;
+			acked = state->count;
+		}
+
+		state->acked = acked;
+		resume = state->parked && flow_has_credit(state);
+		k_mutex_unlock(&link->lock);
+
+		if (resume) {
+			flow_resume(link, entry);
+		}
+	}
+}
+
+/* Report received records to the other domain once half of a channel's credits are used up.
+ * Runs on the link's sender thread.
+ */
+static void flow_credit_report(struct mdm_link *link)
+{
+	uint8_t report[1 + CREDIT_REPORT_MAX * CREDIT_ENTRY_SIZE];
+	size_t len = 1;
+
+	report[0] = MDM_LINK_CTRL_CREDIT;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		struct mdm_link_chan_state *state = entry->state;
+
+		if (entry->tx || entry->link != link ||
+		    (uint16_t)(state->count - state->acked) < CONFIG_MDM_LINK_CREDITS / 2) {
+			continue;
+		}
+
+		if (len + CREDIT_ENTRY_SIZE > sizeof(report)) {
+			break;
+		}
+
+		report[len] = entry->id;
+		sys_put_le16(state->count, &report[len + 1]);
+		len += CREDIT_ENTRY_SIZE;
+
+		state->acked = state->count;
+	}
+
+	if (len > 1) {
+		ctrl_add(link, report, len);
+	}
+
+	k_mutex_unlock(&link->lock);
+}
+
+/* Restart the credit windows of the channels of a link after the other domain restarted. Must be
+ * called with the link lock held.
+ */
+static void flow_reset(struct mdm_link *link)
+{
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		if (entry->link == link) {
+			entry->state->count = 0;
+			entry->state->acked = 0;
+			entry->state->lost = 0;
+			entry->state->reported = 0;
+			entry->state->parked = false;
+		}
+	}
+}
+
+int mdm_link_flow_stats_get(struct mdm_link *link, struct mdm_link_flow_stats *stats)
+{
+	k_mutex_lock(&link->lock, K_FOREVER);
+	*stats = link->flow;
+	k_mutex_unlock(&link->lock);
+
+	return 0;
+}
+
+#else
+
+static inline bool flow_credit_take(struct mdm_link *link, const struct mdm_link_chan *entry)
+{
+	return true;
+}
+
+static inline void flow_credit_receive(struct mdm_link *link, const uint8_t *data, size_t len)
+{
+}
+
+static inline void flow_credit_report(struct mdm_link *link)
+{
+}
+
+static inline void flow_reset(struct mdm_link *link)
+{
+}
+
+int mdm_link_flow_stats_get(struct mdm_link *link, struct mdm_link_flow_stats *stats)
+{
+	*stats = link->flow;
+
+	return 0;
+}
+
+#endif /* CONFIG_MDM_LINK_FLOW_CONTROL */
+
+/* Called in the publisher's context for every channel added with MDM_LINK_TX_CHAN_ADD() */
+static void link_tx_callback(const struct zbus_channel *chan)
+{
+	const struct mdm_link_chan *entry = link_chan_find_by_chan(chan);
+	struct mdm_link *link;
+	bool queued = false;
+	uint32_t crc = 0;
+	int err;
+
+	if (!entry) {
+		return;
+	}
+
+	link = entry->link;
+
+	/* Computed before taking the link lock, the channel stays locked by its publisher */
+	if (IS_ENABLED(CONFIG_MDM_LINK_SUPPRESS_UNCHANGED) &&
+	    (entry->flags & MDM_LINK_CHAN_SUPPRESS_UNCHANGED)) {
+		crc = crc32_ieee(zbus_chan_const_msg(chan), zbus_chan_msg_size(chan));
+	}
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	entry->state->published = true;
+
+	if ((entry->flags & MDM_LINK_CHAN_SUPPRESS_UNCHANGED) && suppress_check(entry, crc)) {
+		k_mutex_unlock(&link->lock);
+		return;
+	}
+
+	/* An update waiting for room is sent with the channel's latest message, this one */
+	if (entry->state->deferred) {
+		err = -ENOBUFS;
+	} else if (flow_credit_take(link, entry)) {
+		err = record_add(link, entry, &queued);
+	} else {
+		/* Parked until credits come back, or dropped */
+		err = -EAGAIN;
+	}
+
+	if (entry->flags & MDM_LINK_CHAN_SUPPRESS_UNCHANGED) {
+		suppress_update(entry, crc, err);
+	}
+
+	k_mutex_unlock(&link->lock);
+
+	if (queued) {
+		link_kick(link);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(mdm_link_tx, link_tx_callback);
+
+/* Add the latest message of the channels whose update found no room in a frame. Runs on the
+ * link's sender thread.
+ */
+static void link_send_deferred(struct mdm_link *link)
+{
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		bool deferred;
+		bool queued = false;
+
+		if (!entry->tx || entry->link != link) {
+			continue;
+		}
+
+		k_mutex_lock(&link->lock, K_FOREVER);
+		deferred = entry->state->deferred;
+		k_mutex_unlock(&link->lock);
+
+		if (!deferred) {
+			continue;
+		}
+
+		/* Lock order is channel, then link, same as in the publisher's context */
+		if (zbus_chan_claim(entry->chan, LINK_PUB_TIMEOUT)) {
+			k_mutex_lock(&link->lock, K_FOREVER);
+			link->deferred = true;
+			k_mutex_unlock(&link->lock);
+
+			link_kick(link);
+			continue;
+		}
+
+		k_mutex_lock(&link->lock, K_FOREVER);
+
+		if (entry->state->deferred) {
+			/* The record and its credit were counted when the update was published */
+			entry->state->deferred = false;
+			(void)record_put(link, entry, zbus_chan_const_msg(entry->chan), -1,
+					 &queued);
+		}
+
+		k_mutex_unlock(&link->lock);
+
+		(void)zbus_chan_finish(entry->chan);
+	}
+}
+
+/* Runs on the link's sender thread */
+static void tx_work_handler(struct k_work *work)
+{
+	struct mdm_link *link = CONTAINER_OF(work, struct mdm_link, tx_work);
+	bool reports_due;
+	bool deferred;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+	reports_due = link->reports_due;
+	deferred = link->deferred;
+	link->reports_due = false;
+	link->deferred = false;
+	k_mutex_unlock(&link->lock);
+
+	if (reports_due) {
+		retx_ack_report(link);
+		flow_credit_report(link);
+	}
+
+	if (deferred) {
+		link_send_deferred(link);
+	}
+
+	(void)link_drain(link, K_NO_WAIT);
+}
+
+#if defined(CONFIG_MDM_LINK_RESYNC)
+
+ZBUS_CHAN_DEFINE(
+	MDM_LINK_SYNC_CHAN,
+	struct mdm_link_sync_msg,
+	NULL,
+	NULL,
+	ZBUS_OBSERVERS_EMPTY,
+	ZBUS_MSG_INIT(0)
+);
+
+/* Handshake record: type, stage and LE32 nonce */
+#define HELLO_SIZE 6
+
+/* Must be called with the link lock held */
+static void hello_add(struct mdm_link *link, struct mdm_link_lane *lane, uint8_t stage,
+		      bool urgent)
+{
+	uint8_t hello[HELLO_SIZE] = { MDM_LINK_CTRL_HELLO, stage };
+
+	sys_put_le32(link->nonce, &hello[2]);
+	ctrl_record_add(link, lane, hello, sizeof(hello), urgent);
+}
+
+/* Send the latest message of every channel this domain published on a link as one batch,
+ * followed by the next handshake stage. Runs on the link's sender thread.
+ */
+static void link_replay(struct mdm_link *link, uint8_t stage)
+{
+	uint32_t replayed = 0;
+
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		/* The lanes are queued and the sender kicked once every channel is added */
+		bool queued = false;
+
+		if (!entry->tx || entry->link != link) {
+			continue;
+		}
+
+		/* Lock order is channel, then link, same as in the publisher's context */
+		if (zbus_chan_claim(entry->chan, LINK_PUB_TIMEOUT)) {
+			LOG_WRN("Cannot replay %s on the %s link", zbus_chan_name(entry->chan),
+				link->name);
+			continue;
+		}
+
+		k_mutex_lock(&link->lock, K_FOREVER);
+
+		/* The replayed message becomes the last one sent */
+		entry->state->last_valid = false;
+
+		if (entry->state->published && flow_credit_take(link, entry)) {
+			(void)record_add(link, entry, &queued);
+			replayed++;
+		}
+
+		k_mutex_unlock(&link->lock);
+
+		(void)zbus_chan_finish(entry->chan);
+	}
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	/* Behind the records of the lowest priority lane, and the lanes are sent highest priority
+	 * first, so the other domain gets the stage after the replayed records.
+	 */
+	hello_add(link, &link->lanes[ARRAY_SIZE(link->lanes) - 1], stage, false);
+
+	for (size_t i = 0; i < ARRAY_SIZE(link->lanes); i++) {
+		(void)lane_queue(link, &link->lanes[i]);
+	}
+
+	k_mutex_unlock(&link->lock);
+
+	link_kick(link);
+
+	LOG_DBG("Replayed %u channels on the %s link", replayed, link->name);
+}
+
+/* Runs on the link's sender thread, the replay fills more frames than the lanes hold */
+static void replay_work_handler(struct k_work *work)
+{
+	struct mdm_link *link = CONTAINER_OF(work, struct mdm_link, replay_work);
+	uint8_t stage;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+	stage = link->replay_stage;
+	k_mutex_unlock(&link->lock);
+
+	link_replay(link, stage);
+}
+
+static void replay_schedule(struct mdm_link *link, uint8_t stage)
+{
+	k_mutex_lock(&link->lock, K_FOREVER);
+	link->replay_stage = stage;
+	k_mutex_unlock(&link->lock);
+
+	(void)k_work_submit_to_queue(&link->workq, &link->replay_work);
+}
+
+static void sync_publish(struct mdm_link *link, bool peer_restarted)
+{
+	const struct mdm_link_sync_msg msg = {
+		.link = link,
+		.peer_restarted = peer_restarted,
+	};
+	int err;
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+	link->synced = true;
+	k_mutex_unlock(&link->lock);
+
+	LOG_INF("The %s link is synced", link->name);
+
+	err = zbus_chan_pub(&MDM_LINK_SYNC_CHAN, &msg, LINK_PUB_TIMEOUT);
+	if (err) {
+		LOG_WRN("zbus_chan_pub, error: %d", err);
+	}
+}
+
+/* Handle a handshake record from the other domain */
+static void hello_receive(struct mdm_link *link, const uint8_t *data, size_t len)
+{
+	uint8_t stage;
+	uint32_t nonce;
+
+	if (len < HELLO_SIZE - 1) {
+		return;
+	}
+
+	stage = data[0];
+	nonce = sys_get_le32(&data[1]);
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	/* Requests are repeated with the same nonce until answered, a new nonce means the other
+	 * domain restarted. Nonces are drawn at random on every start.
+	 */
+	if (stage == MDM_LINK_HELLO_REQ && (!link->peer_seen || nonce != link->peer_nonce)) {
+		link->peer_nonce = nonce;
+		link->synced = false;
+		flow_reset(link);
+		retx_reset(link);
+	}
+
+	link->peer_seen = true;
+
+	k_mutex_unlock(&link->lock);
+
+	switch (stage) {
+	case MDM_LINK_HELLO_REQ:
+		replay_schedule(link, MDM_LINK_HELLO_ACK);
+		break;
+	case MDM_LINK_HELLO_ACK:
+		replay_schedule(link, MDM_LINK_HELLO_DONE);
+		sync_publish(link, false);
+		break;
+	case MDM_LINK_HELLO_DONE:
+		sync_publish(link, true);
+		break;
+	default:
+		LOG_DBG("Unknown handshake stage %u on the %s link", stage, link->name);
+		break;
+	}
+}
+
+/* Runs on the link's sender thread until the other domain answers */
+static void hello_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct mdm_link *link = CONTAINER_OF(dwork, struct mdm_link, hello_work);
+
+	k_mutex_lock(&link->lock, K_FOREVER);
+
+	if (link->peer_seen) {
+		k_mutex_unlock(&link->lock);
+		return;
+	}
+
+	/* Drawn on the first request rather than at init, where the entropy source may not be
+	 * ready yet. The cycle count only guards against a weak random source, it is close to
+	 * the same on every start.
+	 */
+	if (link->nonce == 0) {
+		link->nonce = sys_rand32_get() ^ k_cycle_get_32();
+	}
+
+	hello_add(link, &link->lanes[0], MDM_LINK_HELLO_REQ, true);
+
+	k_mutex_unlock(&link->lock);
+
+	(void)link_drain(link, K_NO_WAIT);
+
+	(void)k_work_schedule_for_queue(&link->workq, &link->hello_work,
+					K_MSEC(CONFIG_MDM_LINK_RESYNC_RETRY_MS));
+}
+
+bool mdm_link_chan_synced(const struct zbus_channel *chan)
+{
+	bool synced;
+
+	STRUCT_SECTION_FOREACH(mdm_link_chan, entry) {
+		if (entry->chan == chan) {
+			k_mutex_lock(&entry->link->lock, K_FOREVER);
+			synced = entry->link->synced;
+			k_mutex_unlock(&entry->link->lock);
+
+			return synced;
+		}
+	}
+
+	return false;
+}
+
+#else
+
+static inline void hello_receive(struct mdm_link *link, const uint8_t *data, size_t len)
+{
+}
+
+#endif /* CONFIG_MDM_LINK_RESYNC */
+
+static int record_decode(const struct mdm_link_chan *entry, const uint8_t *data, size_t len,
+			 const struct mdm_link_codec_ctx *ctx)
+{
+	const struct zbus_channel *chan = entry->chan;
+	int err;
+
+	if (!entry->codec) {
+		if (len != zbus_chan_msg_size(chan)) {
+			LOG_WRN("%s record size mismatch (%zu != %u)", zbus_chan_name(chan), len,
+				zbus_chan_msg_size(chan));
+			return -EMSGSIZE;
+		}
+
+		return zbus_chan_pub(chan, data, LINK_PUB_TIMEOUT);
+	}
+
+	/* Decode straight into the channel message instead of going through a local copy */
+	err = zbus_chan_claim(chan, LINK_PUB_TIMEOUT);
+	if (err) {
+		return err;
+	}
+
+	err = entry->codec->decode(data, len, zbus_chan_msg(chan), ctx);
+
+	(void)zbus_chan_finish(chan);
+
+	if (err) {
+		LOG_WRN("Cannot decode %s record, error: %d", zbus_chan_name(chan), err);
+		return err;
+	}
+
+	return zbus_chan_notify(chan, LINK_PUB_TIMEOUT);
+}
+
+static void ctrl_receive(struct mdm_link *link, const uint8_t *data, size_t len)
+{
+	if (len == 0) {
+		return;
+	}
+
+	switch (data[0]) {
+	case MDM_LINK_CTRL_CREDIT:
+		flow_credit_receive(link, &data[1], len - 1);
+		break;
+	case MDM_LINK_CTRL_HELLO:
+		hello_receive(link, &data[1], len - 1);
+		break;
+	case MDM_LINK_CTRL_SEQ_ACK:
+		retx_ack_receive(link, &data[1], len - 1);
+		break;
+	case MDM_LINK_CTRL_SEQ_SKIP:
+		retx_skip_receive(link, &data[1], len - 1);
+		break;
+	default:
+		LOG_DBG("Unknown control record type %u on the %s link", data[0], link->name);
+		break;
+	}
+}
+
+#if defined(CONFIG_MDM_LINK_FAULT_INJECTION)
+/* Emulates a lossy transport. Calls from several receive contexts may race, which only changes
+ * the pattern of dropped frames.
+ */
+static bool fault_drop(void)
+{
+	static uint32_t state = 0x2545f491;
+
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+
+	return (state % 1000) < CONFIG_MDM_LINK_FAULT_DROP_PERMILLE;
+}
+#else
+static inline bool fault_drop(void)
+{
+	return false;
+}
+#endif /* CONFIG_MDM_LINK_FAULT_INJECTION */
+
+void mdm_link_receive(struct mdm_link *link, const uint8_t *buf, size_t len)
+{
+	struct mdm_link_frame_hdr frame_hdr;
+	struct mdm_link_codec_ctx ctx;
+	const uint8_t *data = buf + sizeof(frame_hdr);
+	const uint8_t *payload;
+	size_t payload_len;
+	size_t offset = 0;
+
+	if (fault_drop()) {
+		LOG_DBG("Dropping frame on the %s link", link->name);
+		return;
+	}
+
+	if (len < sizeof(frame_hdr)) {
+		LOG_WRN("Short frame on the %s link", link->name);
+		return;
+	}
+
+	memcpy(&frame_hdr, buf, sizeof(frame_hdr));
+
+	if (frame_hdr.len > len - sizeof(frame_hdr)) {
+		LOG_WRN("Invalid frame length %u on the %s link", frame_hdr.len, link->name);
+		return;
+	}
+
+	ctx.frame_time = frame_hdr.time;
+
+	while (offset + sizeof(struct mdm_link_record_hdr) <= frame_hdr.len) {
+		struct mdm_link_record_hdr hdr;
+		const struct mdm_link_chan *entry;
+		int err;
+
+		memcpy(&hdr, &data[offset], sizeof(hdr));
+		offset += sizeof(hdr);
+
+		if (hdr.len > frame_hdr.len - offset) {
+			LOG_WRN("Truncated record, id: %u", hdr.id);
+			break;
+		}
+
+		if (hdr.id == MDM_LINK_ID_CONTROL) {
+			ctrl_receive(link, &data[offset], hdr.len);
+			offset += hdr.len;
+			continue;
+		}
+
+		entry = link_chan_find_by_id(link, hdr.id & ~MDM_LINK_ID_SEQ, false);
+		if (!entry) {
+			LOG_WRN("No channel for record id %u on the %s link", hdr.id, link->name);
+			offset += hdr.len;
+			continue;
+		}
+
+		payload = &data[offset];
+		payload_len = hdr.len;
+		offset += hdr.len;
+
+		if (hdr.id & MDM_LINK_ID_SEQ) {
+			if (payload_len == 0 || !IS_ENABLED(CONFIG_MDM_LINK_RELIABLE)) {
+				LOG_WRN("Unexpected sequenced %s record",
+					zbus_chan_name(entry->chan));
+				continue;
+			}
+
+			/* Duplicates and records after a gap take no credit on the other domain */
+			if (!retx_accept(link, entry, payload[0])) {
+				continue;
+			}
+
+			payload++;
+			payload_len--;
+		}
+
+		err = record_decode(entry, payload, payload_len, &ctx);
+		if (err) {
+			LOG_ERR("Cannot publish %s record, error: %d", zbus_chan_name(entry->chan),
+				err);
+			mdm_stats_pub_failed(entry->chan, err);
+		}
+
+		/* Read by the credit reports and the statistics under the link lock */
+		k_mutex_lock(&link->lock, K_FOREVER);
+		entry->state->errors += (err != 0);
+		entry->state->count++;
+		entry->state->records++;
+		k_mutex_unlock(&link->lock);
+	}
+
+	/* Reports are added by the sender thread, so that the receive path never waits for a
+	 * frame to be sent
+	 */
+	if (IS_ENABLED(CONFIG_MDM_LINK_FLOW_CONTROL) || IS_ENABLED(CONFIG_MDM_LINK_RELIABLE)) {
+		k_mutex_lock(&link->lock, K_FOREVER);
+		link->reports_due = true;
+		k_mutex_unlock(&link->lock);
+
+		link_kick(link);
+	}
+}
+
+static int mdm_link_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(links); i++) {
+		struct mdm_link *link = links[i];
+
+		struct k_work_queue_config cfg = {
+			.name = link->name,
+		};
+
+		k_mutex_init(&link->lock);
+		k_mutex_init(&link->send_lock);
+
+		for (size_t j = 0; j < ARRAY_SIZE(link->lanes); j++) {
+			link->lanes[j].link = link;
+			k_work_init_delayable(&link->lanes[j].flush_work, flush_work_handler);
+		}
+
+		k_work_init(&link->tx_work, tx_work_handler);
+#if defined(CONFIG_MDM_LINK_FLOW_CONTROL)
+		k_work_init_delayable(&link->credit_work, credit_work_handler);
+#endif
+#if defined(CONFIG_MDM_LINK_RELIABLE)
+		k_work_init_delayable(&link->retx_work, retx_work_handler);
+#endif
+		k_work_queue_start(&link->workq, link_stacks[i],
+				   K_THREAD_STACK_SIZEOF(link_stacks[i]), CONFIG_MDM_LINK_TX_PRIORITY,
+				   &cfg);
+
+#if defined(CONFIG_MDM_LINK_RESYNC)
+		k_work_init_delayable(&link->hello_work, hello_work_handler);
+		k_work_init(&link->replay_work, replay_work_handler);
+		(void)k_work_schedule_for_queue(&link->workq, &link->hello_work, K_NO_WAIT);
+#endif
+	}
+
+	return 0;
+}
+
+SYS_INIT(mdm_link_init, POST_KERNEL, 0);
@@ -0,0 +1,670 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Multi-domain link.
+ *
+ * Carries module channels between domains as multi-record frames. Updates published
+ * within a short window are coalesced and sent as one transfer, so the per-transfer
+ * header, CRC and DMA setup cost is paid once per frame instead of once per publish.
+ *
+ * Frames are carried either by a proxy agent or by a shared-memory ipc_service endpoint.
+ * The transport of a channel follows the node the module is built with: channels whose
+ * MDM_*_PROXY_NODE is MDM_LINK_IPC_NODE use the shared-memory transport, channels whose
+ * node is MDM_LINK_PROXY2_NODE use the second proxy agent, and all others use the proxy
+ * agent in MDM_LINK_PROXY_NODE. Each transport sends from its own thread.
+ *
+ * Modules use MDM_PROXY_ADD_CHAN() and MDM_SHADOW_CHAN_DEFINE() instead of the proxy agent
+ * macros. With CONFIG_MDM_LINK disabled they map directly to ZBUS_PROXY_ADD_CHAN() and
+ * ZBUS_SHADOW_CHAN_DEFINE().
+ */
+
+#ifndef MDM_LINK_H__
+#define MDM_LINK_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Record identifiers of the channels carried on the link. Must match on both domains.
+ * Identifier 0 is reserved for the link's own control records, and identifiers must be below
+ * MDM_LINK_ID_SEQ.
+ */
+enum mdm_link_chan_id {
+	MDM_LINK_ID_LED = 1,
+	MDM_LINK_ID_BLE_NUS,
+	MDM_LINK_ID_CS_DISTANCE,
+	MDM_LINK_ID_PROXY_BENCH_PING,
+	MDM_LINK_ID_PROXY_BENCH_PONG,
+	MDM_LINK_ID_TIME_REQ,
+	MDM_LINK_ID_TIME_RESP,
+	MDM_LINK_ID_STATS,
+	MDM_LINK_ID_HEALTH,
+	MDM_LINK_ID_BLE_NUS_TX,
+	MDM_LINK_ID_BLE_NUS_TX_STATUS,
+};
+
+/** Options of a channel carried on the link */
+enum mdm_link_chan_flags {
+	/**
+	 * Do not send an update whose message is identical to the last one sent, so periodic
+	 * refreshes of an unchanged state cost neither link traffic nor work on the other
+	 * domain. Messages are compared as a whole, padding included, so publishers should
+	 * zero-initialize them. Needs CONFIG_MDM_LINK_SUPPRESS_UNCHANGED, ignored otherwise.
+	 */
+	MDM_LINK_CHAN_SUPPRESS_UNCHANGED = BIT(0),
+
+	/**
+	 * Number the records of the channel, and send them again until the other domain
+	 * acknowledges them. The other domain publishes the records in order, without gaps,
+	 * unless a record had to be given up. Needs CONFIG_MDM_LINK_RELIABLE, ignored otherwise.
+	 */
+	MDM_LINK_CHAN_RELIABLE = BIT(1),
+};
+
+/** True if a message of the type fits in a retransmit buffer record */
+#if defined(CONFIG_MDM_LINK_RELIABLE)
+#define MDM_LINK_RETX_FITS(_type) (sizeof(_type) <= CONFIG_MDM_LINK_RETX_SLOT_SIZE)
+#else
+#define MDM_LINK_RETX_FITS(_type) true
+#endif
+
+/** Set in the record identifier of records that start with a sequence number */
+#define MDM_LINK_ID_SEQ BIT(7)
+
+/** Pair of channels swapped by the loopback stand-in of the shared-memory link */
+struct mdm_link_mirror {
+	/** Record identifier of a channel this domain transmits */
+	uint8_t tx_id;
+
+	/** Record identifier of a channel this domain receives */
+	uint8_t rx_id;
+};
+
+/**
+ * @brief Receive the records of a transmitted channel as records of a received channel.
+ *
+ * With CONFIG_MDM_LINK_IPC_LOOPBACK, the loopback has no other domain to answer, so it stands
+ * in for one: records of the transmitted channel are delivered to the received channel, and
+ * the credit and acknowledgment reports of the received channel return to the transmitted
+ * one. Both channels must have the same message type and codec. Expands to nothing without
+ * the loopback.
+ *
+ * @param _name Name of the pair, unique in the image.
+ * @param _tx_id Record identifier of the transmitted channel.
+ * @param _rx_id Record identifier of the received channel.
+ */
+#if defined(CONFIG_MDM_LINK_IPC_LOOPBACK)
+#define MDM_LINK_LOOPBACK_MIRROR(_name, _tx_id, _rx_id)					\
+	BUILD_ASSERT(_tx_id != _rx_id, "Mirrored channels must differ");			\
+	const STRUCT_SECTION_ITERABLE(mdm_link_mirror, _CONCAT(_mdm_link_mirror_, _name)) = {	\
+		.tx_id = _tx_id,								\
+		.rx_id = _rx_id,								\
+	}
+#else
+#define MDM_LINK_LOOPBACK_MIRROR(_name, _tx_id, _rx_id)
+#endif
+
+#if defined(CONFIG_MDM_LINK)
+
+#if defined(CONFIG_MDM_LINK_PROXY)
+/* Frame channels. The runner transmits on the UP channels and receives on the DOWN channels. */
+ZBUS_CHAN_DECLARE(MDM_LINK_UP_CHAN, MDM_LINK_UP_SMALL_CHAN);
+ZBUS_CHAN_DECLARE(MDM_LINK_DOWN_CHAN, MDM_LINK_DOWN_SMALL_CHAN);
+#endif /* CONFIG_MDM_LINK_PROXY */
+
+#if defined(CONFIG_MDM_LINK_PROXY2)
+#ifndef MDM_LINK_PROXY2_NODE
+#error "MDM_LINK_PROXY2_NODE must be defined to use the second proxy agent link"
+#endif
+/* Frame channels of the second proxy agent, in the same directions */
+ZBUS_CHAN_DECLARE(MDM_LINK2_UP_CHAN, MDM_LINK2_UP_SMALL_CHAN);
+ZBUS_CHAN_DECLARE(MDM_LINK2_DOWN_CHAN, MDM_LINK2_DOWN_SMALL_CHAN);
+#endif /* CONFIG_MDM_LINK_PROXY2 */
+
+#if defined(CONFIG_MDM_LINK_IPC) && !defined(MDM_LINK_IPC_NODE)
+#error "MDM_LINK_IPC_NODE must be defined to use the shared-memory link"
+#endif
+
+/* Link instances, one per transport */
+struct mdm_link;
+extern struct mdm_link mdm_link_proxy;
+extern struct mdm_link mdm_link_proxy2;
+extern struct mdm_link mdm_link_ipc;
+
+/* Listener feeding local channel updates into the link */
+ZBUS_OBS_DECLARE(mdm_link_tx);
+
+struct mdm_link_frame_hdr {
+	/** Sender uptime in milliseconds when the first record was added to the frame */
+	uint32_t time;
+
+	/** Number of used bytes in the frame payload */
+	uint16_t len;
+};
+
+/** Header in front of every record in a frame */
+struct mdm_link_record_hdr {
+	uint8_t id;
+	uint8_t len;
+};
+
+/** Largest control record, a credit or acknowledgment report for 16 channels */
+#define MDM_LINK_CTRL_SIZE_MAX 49
+
+/** Frame context passed to codecs */
+struct mdm_link_codec_ctx {
+	/** Frame time, see @ref mdm_link_frame_hdr. Identical when encoding and decoding. */
+	uint32_t frame_time;
+};
+
+/**
+ * @brief Wire encoding of a channel message.
+ *
+ * Without a codec the whole message is copied into the record. A codec lets a channel put
+ * only the meaningful part of its message on the wire.
+ */
+struct mdm_link_codec {
+	/**
+	 * @brief Encode a message into a record payload.
+	 *
+	 * @param msg Message to encode.
+	 * @param buf Buffer to encode into.
+	 * @param size Size of @p buf.
+	 * @param ctx Frame the record is added to.
+	 *
+	 * @return Number of bytes written to @p buf, or a negative error code.
+	 */
+	int (*encode)(const void *msg, uint8_t *buf, size_t size,
+		      const struct mdm_link_codec_ctx *ctx);
+
+	/**
+	 * @brief Decode a record payload into a full message.
+	 *
+	 * The payload must be validated before @p msg is written, since @p msg is the channel's
+	 * own message buffer.
+	 *
+	 * @param buf Record payload.
+	 * @param len Length of the record payload.
+	 * @param msg Message to decode into.
+	 * @param ctx Frame the record was received in.
+	 *
+	 * @return 0 on success, or a negative error code.
+	 */
+	int (*decode)(const uint8_t *buf, size_t len, void *msg,
+		      const struct mdm_link_codec_ctx *ctx);
+};
+
+/**
+ * @brief Encode an unsigned LEB128 varint.
+ *
+ * @return Number of bytes written, or -EMSGSIZE if @p buf is too small.
+ */
+static inline int mdm_link_varint_put(uint32_t value, uint8_t *buf, size_t size)
+{
+	size_t len = 0;
+
+	do {
+		if (len == size) {
+			return -EMSGSIZE;
+		}
+
+		buf[len] = (value & 0x7F) | ((value > 0x7F) ? 0x80 : 0);
+		value >>= 7;
+		len++;
+	} while (value);
+
+	return len;
+}
+
+/**
+ * @brief Decode an unsigned LEB128 varint.
+ *
+ * @return Number of bytes consumed, or -EBADMSG if the varint is truncated or too long.
+ */
+static inline int mdm_link_varint_get(const uint8_t *buf, size_t size, uint32_t *value)
+{
+	*value = 0;
+
+	for (size_t i = 0; i < MIN(size, 5); i++) {
+		*value |= (uint32_t)(buf[i] & 0x7F) << (7 * i);
+
+		if (!(buf[i] & 0x80)) {
+			return i + 1;
+		}
+	}
+
+	return -EBADMSG;
+}
+
+/** Priority lane counters of a link instance */
+struct mdm_link_lane_stats {
+	/** Records waiting in the lane, including those in a frame queued for sending */
+	uint32_t depth;
+
+	/** Highest @ref depth seen */
+	uint32_t max_depth;
+
+	/** Frames sent from the lane */
+	uint32_t frames;
+
+	/** Total time frames waited between being queued and being sent, in microseconds */
+	uint64_t wait_us_total;
+
+	/** Longest time a frame waited between being queued and being sent, in microseconds */
+	uint32_t wait_us_max;
+};
+
+/** Flow control counters of a link instance */
+struct mdm_link_flow_stats {
+	/** Publishes refused by mdm_link_tx_ready() for lack of credits */
+	uint32_t throttled;
+
+	/** Updates overwritten by a newer update of the same channel while waiting for credits */
+	uint32_t dropped;
+
+	/** Credit windows reset after CONFIG_MDM_LINK_CREDIT_TIMEOUT_MS without a credit report */
+	uint32_t resyncs;
+};
+
+/** Retransmission counters of a link instance */
+struct mdm_link_retx_stats {
+	/** Records sent again after a NACK or a timeout */
+	uint32_t retransmits;
+
+	/** Records given up before they were acknowledged, for lack of room or retries */
+	uint32_t abandoned;
+
+	/** Records of the other domain found missing */
+	uint32_t lost;
+
+	/** Missing records of the other domain that it could no longer send */
+	uint32_t skipped;
+
+	/** Records of the other domain received again and discarded */
+	uint32_t duplicates;
+};
+
+/** Counters of a channel carried on the link */
+struct mdm_link_chan_stats {
+	/** True if this domain owns the channel and transmits it */
+	bool tx;
+
+	/** Records added to frames, or records received for channels owned by the other domain */
+	uint32_t records;
+
+	/** Records that could not be encoded, or received records that could not be published */
+	uint32_t errors;
+
+	/** Updates not sent because they were unchanged */
+	uint32_t suppressed;
+};
+
+/** Run-time state of a channel carried on the link, protected by the link lock */
+struct mdm_link_chan_state {
+	/** Records sent, or records received for channels owned by the other domain */
+	uint16_t count;
+
+	/** Records the other domain reported as received, or the count last reported to it */
+	uint16_t acked;
+
+	/** Records given up as lost when the credit window was reset, added to the reports */
+	uint16_t lost;
+
+	/** Count of the latest credit report, reports are cumulative */
+	uint16_t reported;
+
+	/** True if the latest update is waiting for credits */
+	bool parked;
+
+	/** True if the latest update is waiting for room in a frame */
+	bool deferred;
+
+	/** Uptime in milliseconds when the channel ran out of credits */
+	uint32_t blocked_since;
+
+	/** CRC-32 of the last message sent, valid if @ref last_valid is set */
+	uint32_t last_crc;
+	bool last_valid;
+
+	/** Updates not sent because they were identical to the last message sent */
+	uint32_t suppressed;
+
+	/** Records added to frames, or records received for channels owned by the other domain */
+	uint32_t records;
+
+	/** Records that could not be encoded, or received records that could not be published */
+	uint32_t errors;
+
+	/** True once this domain published the channel, so its message is worth replaying */
+	bool published;
+
+	/** Sequence number of the next record sent, or of the next record expected */
+	uint8_t seq;
+
+	/** True if missing records were reported and later records are being discarded */
+	bool nacked;
+
+	/** True if received records are to be acknowledged */
+	bool ack_due;
+
+	/** True if the other domain is to be told to skip records that were given up */
+	bool skip_due;
+};
+
+/** Channel carried on the link */
+struct mdm_link_chan {
+	const struct zbus_channel *chan;
+
+	/** Wire encoding, NULL to send the message as is */
+	const struct mdm_link_codec *codec;
+
+	/** Link instance carrying the channel */
+	struct mdm_link *link;
+
+	struct mdm_link_chan_state *state;
+
+	uint8_t id;
+
+	/** Priority lane the channel's records are sent on, 0 is the highest */
+	uint8_t lane;
+
+	/** True if this domain owns the channel and transmits it */
+	bool tx;
+
+	/** Bitmask of @ref mdm_link_chan_flags */
+	uint8_t flags;
+};
+
+#if defined(CONFIG_MDM_LINK_PROXY2)
+#define Z_MDM_LINK_PROXY_FOR_NODE(_node)							\
+	(DT_SAME_NODE(_node, MDM_LINK_PROXY2_NODE) ? &mdm_link_proxy2 : &mdm_link_proxy)
+#else
+#define Z_MDM_LINK_PROXY_FOR_NODE(_node) (&mdm_link_proxy)
+#endif
+
+#if defined(CONFIG_MDM_LINK_IPC) && defined(CONFIG_MDM_LINK_PROXY)
+#define Z_MDM_LINK_FOR_NODE(_node)								\
+	(DT_SAME_NODE(_node, MDM_LINK_IPC_NODE) ? &mdm_link_ipc : Z_MDM_LINK_PROXY_FOR_NODE(_node))
+#elif defined(CONFIG_MDM_LINK_IPC)
+/* Without the proxy transport, the shared-memory link carries every channel */
+#define Z_MDM_LINK_FOR_NODE(_node) (&mdm_link_ipc)
+#else
+#define Z_MDM_LINK_FOR_NODE(_node) Z_MDM_LINK_PROXY_FOR_NODE(_node)
+#endif
+
+/** Lane of channels that do not set one, the lowest priority lane */
+#define MDM_LINK_LANE_DEFAULT (CONFIG_MDM_LINK_LANES - 1)
+
+#define Z_MDM_LINK_CHAN_ADD(_node, _chan, _id, _codec, _tx, _lane, _flags)			\
+	BUILD_ASSERT(_id > 0 && _id < MDM_LINK_ID_SEQ, "Invalid link record id");		\
+	BUILD_ASSERT(_lane < CONFIG_MDM_LINK_LANES, "Invalid link lane");			\
+	static struct mdm_link_chan_state _CONCAT(_mdm_link_chan_state_, _chan);		\
+	const STRUCT_SECTION_ITERABLE(mdm_link_chan, _CONCAT(_mdm_link_chan_, _chan)) = {	\
+		.chan = &_chan,									\
+		.codec = _codec,								\
+		.link = Z_MDM_LINK_FOR_NODE(_node),						\
+		.state = &_CONCAT(_mdm_link_chan_state_, _chan),				\
+		.id = _id,									\
+		.lane = _lane,									\
+		.tx = _tx,									\
+		.flags = _flags,								\
+	}
+
+/**
+ * @brief Transmit a channel owned by this domain over the link.
+ *
+ * @param _node Node selecting the transport, see MDM_PROXY_ADD_CHAN().
+ * @param _chan Channel to transmit.
+ * @param _id Record identifier, see @ref mdm_link_chan_id.
+ * @param _codec Pointer to the channel's @ref mdm_link_codec, or NULL.
+ * @param _lane Priority lane, 0 is drained first.
+ * @param _flags Bitmask of @ref mdm_link_chan_flags.
+ */
+#define MDM_LINK_TX_CHAN_ADD(_node, _chan, _id, _codec, _lane, _flags)				\
+	Z_MDM_LINK_CHAN_ADD(_node, _chan, _id, _codec, true, _lane, _flags);			\
+	ZBUS_CHAN_ADD_OBS(_chan, mdm_link_tx, 0)
+
+/**
+ * @brief Publish records received over the link to a local channel.
+ *
+ * @param _node Node selecting the transport, see MDM_PROXY_ADD_CHAN().
+ * @param _chan Channel to publish received records to.
+ * @param _id Record identifier, see @ref mdm_link_chan_id.
+ * @param _codec Pointer to the channel's @ref mdm_link_codec, or NULL.
+ */
+#define MDM_LINK_RX_CHAN_ADD(_node, _chan, _id, _codec)					\
+	Z_MDM_LINK_CHAN_ADD(_node, _chan, _id, _codec, false, 0, 0)
+
+/**
+ * @brief Add a module channel owned by this domain to the proxy.
+ *
+ * The channel is sent on the lowest priority lane.
+ *
+ * @param _node Proxy agent node, or MDM_LINK_IPC_NODE to use the shared-memory link.
+ * @param _chan Channel to proxy.
+ * @param _id Link record identifier, see @ref mdm_link_chan_id.
+ */
+#define MDM_PROXY_ADD_CHAN(_node, _chan, _id)							\
+	MDM_LINK_TX_CHAN_ADD(_node, _chan, _id, NULL, MDM_LINK_LANE_DEFAULT, 0)
+
+/**
+ * @brief Same as MDM_PROXY_ADD_CHAN(), with a wire encoding used on the link.
+ *
+ * @param _codec Pointer to the channel's @ref mdm_link_codec.
+ */
+#define MDM_PROXY_ADD_CHAN_WITH_CODEC(_node, _chan, _id, _codec)				\
+	MDM_LINK_TX_CHAN_ADD(_node, _chan, _id, _codec, MDM_LINK_LANE_DEFAULT, 0)
+
+/**
+ * @brief Same as MDM_PROXY_ADD_CHAN_WITH_CODEC(), sent on a given priority lane.
+ *
+ * Records on a higher priority lane are sent before records of lower priority lanes that
+ * are waiting at the same time, so bulk data cannot hold back short status updates.
+ *
+ * @param _codec Pointer to the channel's @ref mdm_link_codec, or NULL.
+ * @param _lane Priority lane, 0 is the highest. Must be below CONFIG_MDM_LINK_LANES.
+ */
+#define MDM_PROXY_ADD_CHAN_WITH_LANE(_node, _chan, _id, _codec, _lane)				\
+	MDM_LINK_TX_CHAN_ADD(_node, _chan, _id, _codec, _lane, 0)
+
+/**
+ * @brief Same as MDM_PROXY_ADD_CHAN_WITH_LANE(), with channel options.
+ *
+ * @param _flags Bitmask of @ref mdm_link_chan_flags.
+ */
+#define MDM_PROXY_ADD_CHAN_WITH_FLAGS(_node, _chan, _id, _codec, _lane, _flags)		\
+	MDM_LINK_TX_CHAN_ADD(_node, _chan, _id, _codec, _lane, _flags)
+
+/**
+ * @brief Define the local copy of a module channel owned by the other domain.
+ *
+ * Takes the same arguments as ZBUS_SHADOW_CHAN_DEFINE(), plus the link record identifier.
+ */
+#define MDM_SHADOW_CHAN_DEFINE(_name, _type, _node, _id, _user_data, _observers, _init_val)	\
+	BUILD_ASSERT(sizeof(_type) <= UINT8_MAX, "Message too large for a link record");	\
+	MDM_SHADOW_CHAN_DEFINE_WITH_CODEC(_name, _type, _node, _id, NULL, _user_data,		\
+					  _observers, _init_val)
+
+/**
+ * @brief Same as MDM_SHADOW_CHAN_DEFINE(), with a wire encoding used on the link.
+ *
+ * @param _codec Pointer to the channel's @ref mdm_link_codec.
+ */
+#define MDM_SHADOW_CHAN_DEFINE_WITH_CODEC(_name, _type, _node, _id, _codec, _user_data,	\
+					  _observers, _init_val)				\
+	ZBUS_CHAN_DEFINE(_name, _type, NULL, _user_data, _observers, _init_val);		\
+	MDM_LINK_RX_CHAN_ADD(_node, _name, _id, _codec)
+
+/**
+ * @brief Get the counters of a priority lane.
+ *
+ * @param link Link instance, &mdm_link_proxy, &mdm_link_proxy2 or &mdm_link_ipc.
+ * @param lane Priority lane.
+ * @param stats Filled with the lane's counters.
+ *
+ * @return 0 on success, -EINVAL if @p lane does not exist.
+ */
+int mdm_link_lane_stats_get(struct mdm_link *link, uint8_t lane,
+			    struct mdm_link_lane_stats *stats);
+
+/**
+ * @brief Get the flow control counters of a link instance.
+ *
+ * @param link Link instance, &mdm_link_proxy, &mdm_link_proxy2 or &mdm_link_ipc.
+ * @param stats Filled with the link's counters.
+ *
+ * @return 0 on success, negative error code otherwise.
+ */
+int mdm_link_flow_stats_get(struct mdm_link *link, struct mdm_link_flow_stats *stats);
+
+/** Message of MDM_LINK_SYNC_CHAN */
+struct mdm_link_sync_msg {
+	/** Link instance whose channels were replayed by the other domain */
+	struct mdm_link *link;
+
+	/** True if the other domain started the handshake after it restarted, false if this one
+	 *  did
+	 */
+	bool peer_restarted;
+};
+
+/**
+ * Published when the other domain has replayed the latest messages of its channels on a link
+ * after one of the domains started, so the local copies of its channels are up to date.
+ * Needs CONFIG_MDM_LINK_RESYNC.
+ */
+ZBUS_CHAN_DECLARE(MDM_LINK_SYNC_CHAN);
+
+/**
+ * @brief Check whether the link carrying a channel completed its link-up handshake.
+ *
+ * @param chan Channel carried on the link, in either direction.
+ *
+ * @return True if the other domain replayed its channels since the last restart of either
+ *	   domain, false otherwise or if the channel is not carried on the link.
+ */
+bool mdm_link_chan_synced(const struct zbus_channel *chan);
+
+/**
+ * @brief Get the retransmission counters of a link instance.
+ *
+ * @param link Link instance, &mdm_link_proxy, &mdm_link_proxy2 or &mdm_link_ipc.
+ * @param stats Filled with the link's counters.
+ *
+ * @return 0 on success, negative error code otherwise.
+ */
+int mdm_link_retx_stats_get(struct mdm_link *link, struct mdm_link_retx_stats *stats);
+
+/**
+ * @brief Get the number of updates of a channel that were not sent because they were
+ *	  unchanged, see @ref MDM_LINK_CHAN_SUPPRESS_UNCHANGED.
+ *
+ * @param chan Channel owned by this domain and carried on the link.
+ * @param suppressed Set to the number of suppressed updates.
+ *
+ * @return 0 on success, -ENOENT if the channel is not transmitted on the link.
+ */
+int mdm_link_chan_suppressed_get(const struct zbus_channel *chan, uint32_t *suppressed);
+
+/**
+ * @brief Get the counters of a channel carried on the link.
+ *
+ * @param chan Channel carried on the link, in either direction.
+ * @param stats Filled with the channel's counters.
+ *
+ * @return 0 on success, -ENOENT if the channel is not carried on the link.
+ */
+int mdm_link_chan_stats_get(const struct zbus_channel *chan, struct mdm_link_chan_stats *stats);
+
+/**
+ * @brief Send all pending records without waiting for the batching window to expire.
+ *
+ * Pending records of every transport are sent.
+ *
+ * @return 0 on success, negative error code otherwise.
+ */
+int mdm_link_flush(void);
+
+#else /* CONFIG_MDM_LINK */
+
+#define MDM_PROXY_ADD_CHAN(_node, _chan, _id)							\
+	ZBUS_PROXY_ADD_CHAN(_node, _chan)
+
+#define MDM_PROXY_ADD_CHAN_WITH_CODEC(_node, _chan, _id, _codec)				\
+	ZBUS_PROXY_ADD_CHAN(_node, _chan)
+
+#define MDM_PROXY_ADD_CHAN_WITH_LANE(_node, _chan, _id, _codec, _lane)				\
+	ZBUS_PROXY_ADD_CHAN(_node, _chan)
+
+#define MDM_PROXY_ADD_CHAN_WITH_FLAGS(_node, _chan, _id, _codec, _lane, _flags)		\
+	ZBUS_PROXY_ADD_CHAN(_node, _chan)
+
+#define MDM_SHADOW_CHAN_DEFINE(_name, _type, _node, _id, _user_data, _observers, _init_val)	\
+	ZBUS_SHADOW_CHAN_DEFINE(_name, _type, _node, _user_data, _observers, _init_val)
+
+#define MDM_SHADOW_CHAN_DEFINE_WITH_CODEC(_name, _type, _node, _id, _codec, _user_data,	\
+					  _observers, _init_val)				\
+	ZBUS_SHADOW_CHAN_DEFINE(_name, _type, _node, _user_data, _observers, _init_val)
+
+#endif /* CONFIG_MDM_LINK */
+
+#if defined(CONFIG_MDM_LINK_FLOW_CONTROL)
+/**
+ * @brief Check that a channel can be published several times without waiting for credits.
+ *
+ * For publishers splitting one update into several messages, which would lose the messages
+ * before the last one while the channel waits for credits.
+ *
+ * @param chan Channel owned by this domain and carried on the link.
+ * @param count Number of messages about to be published.
+ *
+ * @retval 0 The channel has credits for all messages, or is not carried on the link.
+ * @retval -EAGAIN The other domain has not yet consumed enough of the channel's updates.
+ * @retval -EMSGSIZE The messages need more than CONFIG_MDM_LINK_CREDITS credits.
+ */
+int mdm_link_tx_ready_count(const struct zbus_channel *chan, uint16_t count);
+#else
+static inline int mdm_link_tx_ready_count(const struct zbus_channel *chan, uint16_t count)
+{
+	ARG_UNUSED(chan);
+	ARG_UNUSED(count);
+
+	return 0;
+}
+#endif /* CONFIG_MDM_LINK_FLOW_CONTROL */
+
+/**
+ * @brief Check that a channel can be published without waiting for credits.
+ *
+ * Lets a publisher drop or retry an update right away instead of queueing it behind a
+ * receiver that cannot keep up. Updates published anyway are not lost while the channel
+ * waits for credits: the link sends the channel's latest message once credits return,
+ * dropping the updates it replaced. Always 0 without CONFIG_MDM_LINK_FLOW_CONTROL.
+ *
+ * @param chan Channel owned by this domain and carried on the link.
+ *
+ * @retval 0 The channel has credits left, or is not carried on the link.
+ * @retval -EAGAIN The other domain has not yet consumed the channel's earlier updates.
+ */
+static inline int mdm_link_tx_ready(const struct zbus_channel *chan)
+{
+	return mdm_link_tx_ready_count(chan, 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_LINK_H__ */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/atomic.h>
+
+#include "mdm_link.h"
+#include "mdm_link_transport.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(mdm_link, CONFIG_MDM_LINK_LOG_LEVEL);
+
+#if defined(CONFIG_MDM_LINK_IPC_LOOPBACK)
+
+/* Stand-in for the shared-memory transport on hosts without ipc_service, such as native_sim.
+ * Frames are delivered to this domain's own receive path from the system workqueue, so they
+ * arrive asynchronously like they would from the other domain. The frames are passed on as they
+ * are, the link resolves their record ids through the pairs added with MDM_LINK_LOOPBACK_MIRROR().
+ */
+K_MSGQ_DEFINE(loopback_msgq, sizeof(struct mdm_link_frame), CONFIG_MDM_LINK_IPC_LOOPBACK_DEPTH,
+	      4);
+
+static void loopback_work_handler(struct k_work *work)
+{
+	static struct mdm_link_frame frame;
+
+	ARG_UNUSED(work);
+
+	while (k_msgq_get(&loopback_msgq, &frame, K_NO_WAIT) == 0) {
+		mdm_link_receive(&mdm_link_ipc, (const uint8_t *)&frame,
+				 sizeof(frame.hdr) + frame.hdr.len);
+	}
+}
+
+static K_WORK_DEFINE(loopback_work, loopback_work_handler);
+
+int mdm_link_ipc_send(struct mdm_link *link, const struct mdm_link_frame *frame)
+{
+	ARG_UNUSED(link);
+
+	if (k_msgq_put(&loopback_msgq, frame, K_NO_WAIT)) {
+		return -ENOBUFS;
+	}
+
+	(void)k_work_submit(&loopback_work);
+
+	return 0;
+}
+
+#else
+
+#include <zephyr/device.h>
+#include <zephyr/ipc/ipc_service.h>
+
+static struct ipc_ept ept;
+static atomic_t ept_ready;
+
+static void ept_bound(void *priv)
+{
+	ARG_UNUSED(priv);
+
+	atomic_set(&ept_ready, 1);
+
+	LOG_INF("Shared-memory link bound");
+}
+
+/* Called in the ipc_service receive context, the data is only valid during the call */
+static void ept_received(const void *data, size_t len, void *priv)
+{
+	ARG_UNUSED(priv);
+
+	mdm_link_receive(&mdm_link_ipc, data, len);
+}
+
+static struct ipc_ept_cfg ept_cfg = {
+	.name = "mdm_link",
+	.cb = {
+		.bound = ept_bound,
+		.received = ept_received,
+	},
+};
+
+int mdm_link_ipc_send(struct mdm_link *link, const struct mdm_link_frame *frame)
+{
+	ARG_UNUSED(link);
+
+	int ret;
+
+	if (!atomic_get(&ept_ready)) {
+		return -ENOTCONN;
+	}
+
+	/* Only the used part of the frame is copied into shared memory */
+	ret = ipc_service_send(&ept, frame, sizeof(frame->hdr) + frame->hdr.len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return 0;
+}
+
+static int link_ipc_init(void)
+{
+	const struct device *instance = DEVICE_DT_GET(MDM_LINK_IPC_NODE);
+	int err;
+
+	err = ipc_service_open_instance(instance);
+	if (err && err != -EALREADY) {
+		LOG_ERR("ipc_service_open_instance, error: %d", err);
+		return err;
+	}
+
+	err = ipc_service_register_endpoint(instance, &ept, &ept_cfg);
+	if (err) {
+		LOG_ERR("ipc_service_register_endpoint, error: %d", err);
+		return err;
+	}
+
+	return 0;
+}
+
+SYS_INIT(link_ipc_init, POST_KERNEL, CONFIG_MDM_LINK_IPC_INIT_PRIORITY);
+
+#endif /* CONFIG_MDM_LINK_IPC_LOOPBACK */
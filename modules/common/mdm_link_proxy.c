@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
+
+#include "mdm_link.h"
+#include "mdm_link_transport.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(mdm_link, CONFIG_MDM_LINK_LOG_LEVEL);
+
+#ifndef MDM_LINK_PROXY_NODE
+#error "MDM_LINK_PROXY_NODE must be defined to use the multi-domain link"
+#endif
+
+BUILD_ASSERT(IS_ENABLED(CONFIG_MDM_LINK_FRAME_SIZE_AUTO) ||
+	     MDM_LINK_FRAME_SMALL_DATA_SIZE < MDM_LINK_FRAME_DATA_SIZE,
+	     "Small frames must be smaller than regular frames");
+BUILD_ASSERT(offsetof(struct mdm_link_frame_small, data) == sizeof(struct mdm_link_frame_hdr));
+
+#define LINK_PUB_TIMEOUT K_MSEC(CONFIG_MDM_LINK_PUB_TIMEOUT_MS)
+
+#if defined(CONFIG_MDM_LINK_PROXY2)
+#ifndef MDM_LINK_PROXY2_NODE
+#error "MDM_LINK_PROXY2_NODE must be defined to use the second proxy agent link"
+#endif
+BUILD_ASSERT(!DT_SAME_NODE(MDM_LINK_PROXY_NODE, MDM_LINK_PROXY2_NODE),
+	     "The two proxy agent links must use different proxy agents");
+#endif
+
+ZBUS_OBS_DECLARE(mdm_link_rx);
+
+/* Define the frame channels of a proxy agent link. Channels given as _tx are owned by this
+ * domain and sent through the proxy agent, channels given as _rx are received from it.
+ */
+#define LINK_PROXY_CHANS_DEFINE(_config, _node, _tx, _tx_small, _rx, _rx_small)		\
+	ZBUS_CHAN_DEFINE(_tx, struct mdm_link_frame, NULL, NULL, ZBUS_OBSERVERS_EMPTY,		\
+			 ZBUS_MSG_INIT(0));							\
+	ZBUS_CHAN_DEFINE(_tx_small, struct mdm_link_frame_small, NULL, NULL,			\
+			 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));				\
+	ZBUS_PROXY_ADD_CHAN(_node, _tx);							\
+	ZBUS_PROXY_ADD_CHAN(_node, _tx_small);							\
+	ZBUS_SHADOW_CHAN_DEFINE(_rx, struct mdm_link_frame, _node, NULL,			\
+				ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));			\
+	ZBUS_SHADOW_CHAN_DEFINE(_rx_small, struct mdm_link_frame_small, _node, NULL,		\
+				ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));			\
+	ZBUS_CHAN_ADD_OBS(_rx, mdm_link_rx, 0);							\
+	ZBUS_CHAN_ADD_OBS(_rx_small, mdm_link_rx, 0);						\
+	const struct mdm_link_proxy_config _config = {						\
+		.tx_chan = &_tx,								\
+		.tx_small_chan = &_tx_small,							\
+		.rx_chan = &_rx,								\
+		.rx_small_chan = &_rx_small,							\
+	}
+
+/* The frame channels have the same names on both domains, only the direction differs */
+#if defined(CONFIG_MDM_RUNNER_DOMAIN)
+#define LINK_PROXY_DEFINE(_config, _node, _up, _up_small, _down, _down_small)			\
+	LINK_PROXY_CHANS_DEFINE(_config, _node, _up, _up_small, _down, _down_small)
+#else
+#define LINK_PROXY_DEFINE(_config, _node, _up, _up_small, _down, _down_small)			\
+	LINK_PROXY_CHANS_DEFINE(_config, _node, _down, _down_small, _up, _up_small)
+#endif
+
+LINK_PROXY_DEFINE(mdm_link_proxy_config, MDM_LINK_PROXY_NODE,
+		  MDM_LINK_UP_CHAN, MDM_LINK_UP_SMALL_CHAN,
+		  MDM_LINK_DOWN_CHAN, MDM_LINK_DOWN_SMALL_CHAN);
+
+#if defined(CONFIG_MDM_LINK_PROXY2)
+LINK_PROXY_DEFINE(mdm_link_proxy2_config, MDM_LINK_PROXY2_NODE,
+		  MDM_LINK2_UP_CHAN, MDM_LINK2_UP_SMALL_CHAN,
+		  MDM_LINK2_DOWN_CHAN, MDM_LINK2_DOWN_SMALL_CHAN);
+#endif
+
+static struct mdm_link *const proxy_links[] = {
+	&mdm_link_proxy,
+#if defined(CONFIG_MDM_LINK_PROXY2)
+	&mdm_link_proxy2,
+#endif
+};
+
+int mdm_link_proxy_send(struct mdm_link *link, const struct mdm_link_frame *frame)
+{
+	const struct mdm_link_proxy_config *config = link->config;
+	int err;
+	const struct zbus_channel *chan;
+	size_t len = sizeof(frame->hdr) + frame->hdr.len;
+
+	chan = (frame->hdr.len <= MDM_LINK_FRAME_SMALL_DATA_SIZE) ?
+		config->tx_small_chan : config->tx_chan;
+
+	err = zbus_chan_claim(chan, LINK_PUB_TIMEOUT);
+	if (err) {
+		LOG_ERR("zbus_chan_claim, error: %d", err);
+		return err;
+	}
+
+	memcpy(zbus_chan_msg(chan), frame, len);
+
+	(void)zbus_chan_finish(chan);
+
+	LOG_DBG("Sending %zu byte frame on %s", len, zbus_chan_name(chan));
+
+	err = zbus_chan_notify(chan, LINK_PUB_TIMEOUT);
+	if (err) {
+		LOG_ERR("zbus_chan_notify, error: %d", err);
+	}
+
+	return err;
+}
+
+/* Called in the receive context of the proxy agent for every frame from the other domain */
+static void link_rx_callback(const struct zbus_channel *chan)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(proxy_links); i++) {
+		const struct mdm_link_proxy_config *config = proxy_links[i]->config;
+
+		if (chan == config->rx_chan || chan == config->rx_small_chan) {
+			mdm_link_receive(proxy_links[i], zbus_chan_const_msg(chan),
+					 zbus_chan_msg_size(chan));
+			return;
+		}
+	}
+}
+
+ZBUS_LISTENER_DEFINE(mdm_link_rx, link_rx_callback);
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Multi-domain link transport interface.
+ *
+ * Internal to the link. A transport sends complete frames to the other domain and hands
+ * frames received from it to mdm_link_receive().
+ */
+
+#ifndef MDM_LINK_TRANSPORT_H__
+#define MDM_LINK_TRANSPORT_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "mdm_link.h"
+
+#if defined(CONFIG_MDM_LINK_FRAME_SIZE_AUTO)
+#include "mdm_channels.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_MDM_LINK_FRAME_SIZE_AUTO)
+/* Room for one record of the largest message in the image, with its sequence number, or for the
+ * largest control record. Both domains build the same modules, so their frames are the same size.
+ */
+#define MDM_LINK_FRAME_DATA_SIZE								\
+	(sizeof(struct mdm_link_record_hdr) +							\
+	 MAX(MDM_CHANNELS_MSG_SIZE_MAX + 1, MDM_LINK_CTRL_SIZE_MAX))
+#else
+#define MDM_LINK_FRAME_DATA_SIZE CONFIG_MDM_LINK_FRAME_SIZE
+#endif
+
+/* Equal to the regular frame size when all channels in use fit in a small frame */
+#define MDM_LINK_FRAME_SMALL_DATA_SIZE								\
+	MIN(CONFIG_MDM_LINK_FRAME_SMALL_SIZE, MDM_LINK_FRAME_DATA_SIZE)
+
+/** Frame used when the pending records do not fit in a small frame */
+struct mdm_link_frame {
+	struct mdm_link_frame_hdr hdr;
+	uint8_t data[MDM_LINK_FRAME_DATA_SIZE];
+};
+
+/** Frame used for short bursts, so a single small update does not pay for a full frame */
+struct mdm_link_frame_small {
+	struct mdm_link_frame_hdr hdr;
+	uint8_t data[MDM_LINK_FRAME_SMALL_DATA_SIZE];
+};
+
+/* Record identifier of link control records */
+#define MDM_LINK_ID_CONTROL 0
+
+/* First byte of a control record payload */
+enum mdm_link_ctrl_type {
+	/* Followed by (id, LE16 received count) pairs for channels owned by the receiver */
+	MDM_LINK_CTRL_CREDIT = 1,
+
+	/* Followed by a @ref mdm_link_hello_stage and the sender's LE32 nonce */
+	MDM_LINK_CTRL_HELLO = 2,
+
+	/* Followed by (id, next expected sequence number, nack) entries for reliable channels
+	 * owned by the receiver. A set nack asks for the records from the sequence number on.
+	 */
+	MDM_LINK_CTRL_SEQ_ACK = 3,
+
+	/* Followed by the id of a reliable channel owned by the sender and the sequence number
+	 * of its oldest record that can still be sent
+	 */
+	MDM_LINK_CTRL_SEQ_SKIP = 4,
+};
+
+/* Link-up handshake. Each side replays its channels before sending the next stage, so a
+ * side has received the other's replay when it gets the ACK or DONE.
+ */
+enum mdm_link_hello_stage {
+	/* Sent after boot until the other domain answers */
+	MDM_LINK_HELLO_REQ,
+
+	/* Answer to a request, after replaying the channels of the sender */
+	MDM_LINK_HELLO_ACK,
+
+	/* Answer to an ACK, after replaying the channels of the sender */
+	MDM_LINK_HELLO_DONE,
+};
+
+/* Frames of one priority lane */
+struct mdm_link_lane {
+	struct mdm_link *link;
+	struct k_work_delayable flush_work;
+
+	/* Double buffer: one frame collects records while the other is queued for sending. The
+	 * queued frame is owned by the link's sender until its length is reset to zero.
+	 */
+	struct mdm_link_frame frames[2];
+	uint16_t records[2];
+	uint8_t fill;
+
+	/* True if the collecting frame is complete but the queued frame was still being sent, the
+	 * sender queues it next
+	 */
+	bool ready;
+
+	/* Cycle count when the queued frame was queued */
+	uint32_t queued_at;
+
+	struct mdm_link_lane_stats stats;
+};
+
+#if defined(CONFIG_MDM_LINK_RELIABLE)
+/* Record of a reliable channel waiting for an acknowledgment */
+struct mdm_link_retx_slot {
+	/* Channel of the record, NULL if the slot is free */
+	const struct mdm_link_chan *entry;
+
+	/* Uptime in milliseconds when the record was last sent */
+	uint32_t sent_at;
+
+	uint8_t seq;
+	uint8_t tries;
+
+	/* Message as published, encoded again for every frame it is sent in */
+	uint8_t msg[CONFIG_MDM_LINK_RETX_SLOT_SIZE] __aligned(8);
+};
+#endif /* CONFIG_MDM_LINK_RELIABLE */
+
+struct mdm_link {
+	const char *name;
+
+	/**
+	 * @brief Send a frame to the other domain.
+	 *
+	 * Called from the link's sender thread or a flushing thread. Calls are serialized by
+	 * the send lock. The frame may be reused as soon as the call returns.
+	 *
+	 * @return 0 on success, or a negative error code.
+	 */
+	int (*send)(struct mdm_link *link, const struct mdm_link_frame *frame);
+
+	/* Transport specific configuration */
+	const void *config;
+
+	/* Sends queued frames, so that transports progress independently of each other */
+	struct k_work_q workq;
+	struct k_work tx_work;
+
+	/* Protects the lanes, except for frames being sent */
+	struct k_mutex lock;
+
+	/* Held by the thread sending queued frames */
+	struct k_mutex send_lock;
+
+	/* Lane 0 has the highest priority */
+	struct mdm_link_lane lanes[CONFIG_MDM_LINK_LANES];
+
+	struct mdm_link_flow_stats flow;
+
+	/* Work for the sender thread, protected by the lock: reports may be due after a received
+	 * frame, and channels may have updates that found no room in a frame
+	 */
+	bool reports_due;
+	bool deferred;
+
+#if defined(CONFIG_MDM_LINK_FLOW_CONTROL)
+	/* Resets the windows of parked channels that are not published again */
+	struct k_work_delayable credit_work;
+#endif
+
+	/* Link-up handshake, protected by the lock */
+	struct k_work_delayable hello_work;
+	struct k_work replay_work;
+	uint8_t replay_stage;
+	/* Random number telling the starts of this domain apart, 0 until the first request */
+	uint32_t nonce;
+	uint32_t peer_nonce;
+	bool peer_seen;
+	bool synced;
+
+#if defined(CONFIG_MDM_LINK_RELIABLE)
+	/* Records of reliable channels waiting for an acknowledgment, protected by the lock */
+	struct mdm_link_retx_slot retx[CONFIG_MDM_LINK_RETX_SLOTS];
+	struct k_work_delayable retx_work;
+#endif
+
+	struct mdm_link_retx_stats retx_stats;
+};
+
+/**
+ * @brief Publish the records of a frame received from the other domain.
+ *
+ * @param link Link instance the frame was received on.
+ * @param buf Received frame, starting with its @ref mdm_link_frame_hdr. Need not be aligned.
+ * @param len Number of bytes received.
+ */
+void mdm_link_receive(struct mdm_link *link, const uint8_t *buf, size_t len);
+
+int mdm_link_proxy_send(struct mdm_link *link, const struct mdm_link_frame *frame);
+int mdm_link_ipc_send(struct mdm_link *link, const struct mdm_link_frame *frame);
+
+/* Frame channels of a proxy agent transport */
+struct mdm_link_proxy_config {
+	const struct zbus_channel *tx_chan;
+	const struct zbus_channel *tx_small_chan;
+	const struct zbus_channel *rx_chan;
+	const struct zbus_channel *rx_small_chan;
+};
+
+extern const struct mdm_link_proxy_config mdm_link_proxy_config;
+extern const struct mdm_link_proxy_config mdm_link_proxy2_config;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_LINK_TRANSPORT_H__ */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "mdm_msg_pool.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mdm_msg_pool, CONFIG_MDM_MSG_POOL_LOG_LEVEL);
+
+BUILD_ASSERT(MDM_MSG_POOL_BUF_SIZE > 0, "No module channels to size the pool from");
+
+static atomic_t peak;
+static atomic_t full;
+
+static void pool_destroy(struct net_buf *buf);
+
+/* zbus keeps the channel of the message in the user data */
+NET_BUF_POOL_FIXED_DEFINE(mdm_msg_pool, CONFIG_MDM_MSG_POOL_COUNT, MDM_MSG_POOL_BUF_SIZE,
+			  sizeof(struct zbus_channel *), pool_destroy);
+
+static void peak_update(atomic_val_t in_use)
+{
+	atomic_val_t prev = atomic_get(&peak);
+
+	while (in_use > prev && !atomic_cas(&peak, prev, in_use)) {
+		prev = atomic_get(&peak);
+	}
+}
+
+/* Called when the last subscriber releases a message. net_buf has no allocation hook, but every
+ * usage level reached is left by a release, so sampling here and when the counters are read
+ * misses no peak and no time the pool was full.
+ */
+static void pool_destroy(struct net_buf *buf)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+
+	/* The buffer being returned is already counted as available */
+	atomic_val_t in_use = pool->buf_count - atomic_get(&pool->avail_count) + 1;
+
+	peak_update(in_use);
+
+	if (in_use == pool->buf_count) {
+		(void)atomic_inc(&full);
+	}
+
+	net_buf_destroy(buf);
+}
+
+void mdm_msg_pool_stats_get(struct mdm_msg_pool_stats *stats)
+{
+	atomic_val_t in_use = mdm_msg_pool.buf_count - atomic_get(&mdm_msg_pool.avail_count);
+
+	peak_update(in_use);
+
+	stats->count = mdm_msg_pool.buf_count;
+	stats->in_use = (uint16_t)in_use;
+	stats->peak = (uint16_t)atomic_get(&peak);
+
+	/* Including a time that is not over yet */
+	stats->full = (uint32_t)atomic_get(&full) + (in_use == mdm_msg_pool.buf_count);
+}
+
+static int mdm_msg_pool_init(void)
+{
+	STRUCT_SECTION_FOREACH(zbus_channel, chan) {
+		if (zbus_chan_msg_size(chan) > MDM_MSG_POOL_BUF_SIZE) {
+			LOG_DBG("%s keeps the default pool", zbus_chan_name(chan));
+			continue;
+		}
+
+		zbus_chan_set_msg_sub_pool(chan, &mdm_msg_pool);
+	}
+
+	return 0;
+}
+
+/* Before the first publish */
+SYS_INIT(mdm_msg_pool_init, POST_KERNEL, 0);
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Static buffer pool of the message subscribers.
+ *
+ * zbus copies every message published to a channel with message subscribers, such as the proxy
+ * agent, into a net_buf. Instead of the default pool, which allocates the copies from the heap,
+ * channels get a pool of CONFIG_MDM_MSG_POOL_COUNT fixed-size buffers. Buffers are sized to the
+ * largest module message, see mdm_channels.h, or to a link frame when the batched link is used,
+ * so allocation takes constant time and cannot fragment the heap. Channels with larger
+ * messages keep the default pool.
+ */
+
+#ifndef MDM_MSG_POOL_H__
+#define MDM_MSG_POOL_H__
+
+#include <zephyr/kernel.h>
+
+#include "mdm_channels.h"
+
+#if defined(CONFIG_MDM_LINK)
+#include "mdm_link_transport.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of a buffer of the pool */
+#if defined(CONFIG_MDM_LINK)
+#define MDM_MSG_POOL_BUF_SIZE MAX(MDM_CHANNELS_MSG_SIZE_MAX, sizeof(struct mdm_link_frame))
+#else
+#define MDM_MSG_POOL_BUF_SIZE MDM_CHANNELS_MSG_SIZE_MAX
+#endif
+
+/** Usage counters of the pool */
+struct mdm_msg_pool_stats {
+	/** Buffers in the pool */
+	uint16_t count;
+
+	/** Buffers currently holding a message */
+	uint16_t in_use;
+
+	/** Most buffers held at the same time */
+	uint16_t peak;
+
+	/**
+	 * Times all buffers were held at once. A publish needing a buffer meanwhile waited for one,
+	 * and failed if its timeout expired first.
+	 */
+	uint32_t full;
+};
+
+/**
+ * @brief Get the usage counters of the pool.
+ *
+ * @param stats Filled with the counters.
+ */
+void mdm_msg_pool_stats_get(struct mdm_msg_pool_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_MSG_POOL_H__ */
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "mdm_recorder.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mdm_recorder, CONFIG_MDM_RECORDER_LOG_LEVEL);
+
+#define RECORDS CONFIG_MDM_RECORDER_RECORDS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RECORDS), "The number of records must be a power of two");
+
+/* Changes with the layout, so a ring left by another configuration is not used */
+#define RING_MAGIC (0x4d445231 ^ sizeof(struct mdm_recorder_record) ^ RECORDS)
+
+#define ADD_OBS_TIMEOUT K_MSEC(100)
+
+/* Not initialized at boot, so the records survive a warm reset */
+static struct {
+	uint32_t magic;
+	uint32_t boots;
+
+	/* Sequence number of the last claimed record */
+	atomic_t head;
+
+	struct mdm_recorder_record records[RECORDS];
+} ring __noinit;
+
+static atomic_t paused;
+
+TYPE_SECTION_START_EXTERN(struct zbus_channel, zbus_channel);
+
+static inline uint16_t chan_index(const struct zbus_channel *chan)
+{
+	return (uint16_t)(chan - TYPE_SECTION_START(zbus_channel));
+}
+
+const struct zbus_channel *mdm_recorder_chan_get(uint16_t index)
+{
+	struct zbus_channel *chan;
+	size_t count;
+
+	STRUCT_SECTION_COUNT(zbus_channel, &count);
+
+	if (index >= count) {
+		return NULL;
+	}
+
+	STRUCT_SECTION_GET(zbus_channel, index, &chan);
+
+	return chan;
+}
+
+/* Word-wise multiplicative hash, a few cycles per four bytes */
+static uint32_t msg_hash(const uint8_t *msg, size_t len)
+{
+	uint32_t hash = 0x811c9dc5 ^ (uint32_t)len;
+	uint32_t word;
+	size_t i = 0;
+
+	for (; i + sizeof(word) <= len; i += sizeof(word)) {
+		memcpy(&word, &msg[i], sizeof(word));
+		hash = (hash ^ word) * 0x01000193;
+	}
+
+	for (; i < len; i++) {
+		hash = (hash ^ msg[i]) * 0x01000193;
+	}
+
+	return hash ^ (hash >> 16);
+}
+
+static void record_write(uint32_t cycles, uint16_t chan, uint32_t thread, const uint8_t *msg,
+			 size_t len)
+{
+	uint32_t seq = (uint32_t)atomic_inc(&ring.head) + 1;
+	struct mdm_recorder_record *record = &ring.records[seq & (RECORDS - 1)];
+
+	/* Readers skip the record until its sequence number is written again */
+	record->seq = 0;
+	barrier_dmem_fence_full();
+
+	record->cycles = cycles;
+	record->thread = thread;
+	record->hash = msg_hash(msg, len);
+	record->chan = chan;
+	record->len = (uint16_t)MIN(len, UINT16_MAX);
+	memcpy(record->payload, msg, MIN(len, sizeof(record->payload)));
+
+	barrier_dmem_fence_full();
+	record->seq = seq;
+}
+
+/* Called in the publisher's context after the static observers of the channel */
+static void record_callback(const struct zbus_channel *chan)
+{
+	uint32_t cycles = k_cycle_get_32();
+
+	if (atomic_get(&paused)) {
+		return;
+	}
+
+	record_write(cycles, chan_index(chan), (uint32_t)(uintptr_t)k_current_get(),
+		     zbus_chan_const_msg(chan), zbus_chan_msg_size(chan));
+}
+
+ZBUS_LISTENER_DEFINE(mdm_recorder, record_callback);
+
+size_t mdm_recorder_foreach(size_t max, mdm_recorder_cb_t cb, void *user_data)
+{
+	uint32_t head = (uint32_t)atomic_get(&ring.head);
+	uint32_t available = MIN(head, RECORDS);
+	size_t count = 0;
+
+	if (max > 0 && max < available) {
+		available = max;
+	}
+
+	for (uint32_t seq = head - available + 1; seq != head + 1; seq++) {
+		const struct mdm_recorder_record *slot = &ring.records[seq & (RECORDS - 1)];
+		struct mdm_recorder_record record;
+
+		memcpy(&record, slot, sizeof(record));
+		barrier_dmem_fence_full();
+
+		/* Unused, or written again while it was copied */
+		if (record.seq != seq || *(volatile const uint32_t *)&slot->seq != seq) {
+			continue;
+		}
+
+		count++;
+
+		if (!cb(&record, user_data)) {
+			break;
+		}
+	}
+
+	return count;
+}
+
+void mdm_recorder_pause(bool pause)
+{
+	atomic_set(&paused, pause);
+}
+
+void mdm_recorder_clear(void)
+{
+	for (size_t i = 0; i < RECORDS; i++) {
+		ring.records[i].seq = 0;
+	}
+}
+
+static int mdm_recorder_init(void)
+{
+	int err;
+
+	if (ring.magic != RING_MAGIC) {
+		memset(&ring, 0, sizeof(ring));
+		ring.magic = RING_MAGIC;
+	}
+
+	ring.boots++;
+	record_write(k_cycle_get_32(), MDM_RECORDER_CHAN_BOOT, ring.boots, NULL, 0);
+
+	STRUCT_SECTION_FOREACH(zbus_channel, chan) {
+		err = zbus_chan_add_obs(chan, &mdm_recorder, ADD_OBS_TIMEOUT);
+		if (err) {
+			LOG_ERR("Cannot record %s, error: %d", zbus_chan_name(chan), err);
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(mdm_recorder_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
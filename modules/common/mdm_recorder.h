@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Flight recorder of channel traffic.
+ *
+ * A listener added at runtime to every channel of the image stores one fixed-size record per
+ * publish in a RAM ring: channel index, cycle counter, publishing thread, a hash of the whole
+ * message and its first bytes. Slots are claimed with a single atomic increment, so publishers
+ * never wait on each other and the cost per publish stays constant. The ring is not
+ * initialized at boot, so the records leading up to a warm reset, for example after a fatal
+ * error or watchdog timeout, can be read out after the reboot.
+ */
+
+#ifndef MDM_RECORDER_H__
+#define MDM_RECORDER_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Channel index of the record written at every boot */
+#define MDM_RECORDER_CHAN_BOOT UINT16_MAX
+
+/** One publish */
+struct mdm_recorder_record {
+	/** Position in the ring, increasing across warm resets. Written last, 0 if unused. */
+	uint32_t seq;
+
+	/** Cycle counter when the listener was called */
+	uint32_t cycles;
+
+	/** Publishing thread, the boot count for MDM_RECORDER_CHAN_BOOT */
+	uint32_t thread;
+
+	/** Hash of the whole message */
+	uint32_t hash;
+
+	/** Index of the channel in the zbus channel section, see mdm_recorder_chan_get() */
+	uint16_t chan;
+
+	/** Size of the whole message */
+	uint16_t len;
+
+	/** First bytes of the message */
+	uint8_t payload[CONFIG_MDM_RECORDER_PAYLOAD_SIZE];
+};
+
+/**
+ * @brief Record callback.
+ *
+ * @param record Consistent copy of a record.
+ * @param user_data User data given to mdm_recorder_foreach().
+ *
+ * @return true to continue with the next record, false to stop.
+ */
+typedef bool (*mdm_recorder_cb_t)(const struct mdm_recorder_record *record, void *user_data);
+
+/**
+ * @brief Go through the most recent records, oldest first.
+ *
+ * Records can be read while publishers keep adding new ones. Records that are overwritten
+ * while they are read are skipped.
+ *
+ * @param max Maximum number of records, 0 for all records in the ring.
+ * @param cb Called for every record.
+ * @param user_data Passed to cb.
+ *
+ * @return Number of records passed to cb.
+ */
+size_t mdm_recorder_foreach(size_t max, mdm_recorder_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the channel of a record.
+ *
+ * @param index Channel index of a record.
+ *
+ * @return Channel, or NULL for a boot record or an index beyond the channels of this image.
+ */
+const struct zbus_channel *mdm_recorder_chan_get(uint16_t index);
+
+/**
+ * @brief Stop or resume recording.
+ *
+ * Pausing keeps the records leading up to an event while they are read out.
+ *
+ * @param pause true to stop recording.
+ */
+void mdm_recorder_pause(bool pause);
+
+/**
+ * @brief Discard all records.
+ */
+void mdm_recorder_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_RECORDER_H__ */
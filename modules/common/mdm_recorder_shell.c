@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "mdm_recorder.h"
+
+struct dump_ctx {
+	const struct shell *sh;
+	bool first;
+	uint32_t prev_cycles;
+};
+
+static bool dump_record(const struct mdm_recorder_record *record, void *user_data)
+{
+	struct dump_ctx *ctx = user_data;
+	const struct zbus_channel *chan = mdm_recorder_chan_get(record->chan);
+	uint32_t delta_us = 0;
+
+	if (record->chan == MDM_RECORDER_CHAN_BOOT) {
+		shell_print(ctx->sh, "%10u  --- boot %u ---", record->seq, record->thread);
+		ctx->first = true;
+		return true;
+	}
+
+	/* Time since the previous publish, cycle counts are not comparable across boots */
+	if (!ctx->first) {
+		delta_us = (uint32_t)k_cyc_to_us_floor64(record->cycles - ctx->prev_cycles);
+	}
+
+	ctx->first = false;
+	ctx->prev_cycles = record->cycles;
+
+	shell_fprintf(ctx->sh, SHELL_NORMAL, "%10u %10u +%8u us %08x %-24s %4u %08x ",
+		      record->seq, record->cycles, delta_us, record->thread,
+		      chan ? zbus_chan_name(chan) : "?", record->len, record->hash);
+
+	for (size_t i = 0; i < MIN(record->len, sizeof(record->payload)); i++) {
+		shell_fprintf(ctx->sh, SHELL_NORMAL, "%02x", record->payload[i]);
+	}
+
+	shell_fprintf(ctx->sh, SHELL_NORMAL, "\n");
+
+	return true;
+}
+
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	struct dump_ctx ctx = {
+		.sh = sh,
+		.first = true,
+	};
+	size_t max = 0;
+	size_t count;
+
+	if (argc > 1) {
+		max = strtoul(argv[1], NULL, 0);
+	}
+
+	shell_print(sh, "%10s %10s %12s %8s %-24s %4s %8s payload", "seq", "cycles", "delta",
+		    "thread", "channel", "len", "hash");
+
+	count = mdm_recorder_foreach(max, dump_record, &ctx);
+
+	shell_print(sh, "%zu records", count);
+
+	return 0;
+}
+
+static int cmd_pause(const struct shell *sh, size_t argc, char **argv)
+{
+	mdm_recorder_pause(true);
+
+	return 0;
+}
+
+static int cmd_resume(const struct shell *sh, size_t argc, char **argv)
+{
+	mdm_recorder_pause(false);
+
+	return 0;
+}
+
+static int cmd_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	mdm_recorder_clear();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_mdm_recorder,
+	SHELL_CMD_ARG(dump, NULL, "Print the most recent records [count]", cmd_dump, 1, 1),
+	SHELL_CMD(pause, NULL, "Stop recording", cmd_pause),
+	SHELL_CMD(resume, NULL, "Resume recording", cmd_resume),
+	SHELL_CMD(clear, NULL, "Discard all records", cmd_clear),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(mdm_recorder, &sub_mdm_recorder, "Channel traffic flight recorder", NULL);
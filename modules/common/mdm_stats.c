@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
+
+#include "mdm_stats.h"
+#include "mdm_link.h"
+#include "mdm_channels.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mdm_stats, CONFIG_MDM_STATS_LOG_LEVEL);
+
+#if defined(CONFIG_MDM_STATS_PUBLISH) && !defined(MDM_STATS_NODE)
+#error "MDM_STATS_NODE must be defined to publish statistics to the other domain"
+#endif
+
+#define ADD_OBS_TIMEOUT K_MSEC(100)
+#define STATS_PUB_TIMEOUT K_MSEC(100)
+
+struct stats_entry {
+	const struct zbus_channel *chan;
+	uint8_t id;
+
+	/* Cycle counter when mdm_stats_begin was notified. Only written by the publisher, which
+	 * holds the channel while its observers are notified.
+	 */
+	uint32_t start;
+	bool started;
+
+	uint32_t pubs;
+	uint32_t pub_timeouts;
+	uint64_t obs_cycles_total;
+	uint32_t obs_cycles_max;
+
+#if defined(CONFIG_MDM_LINK)
+	/* Link counters at the last reset */
+	struct mdm_link_chan_stats link_base;
+#endif
+
+	/* Latest statistics received from the runner domain */
+	struct mdm_stats_msg remote;
+	bool remote_valid;
+};
+
+#define STATS_ENTRY(_chan, _type, _owner, _node, _id, ...) { .chan = &_chan, .id = _id },
+
+static struct stats_entry entries[] = {
+	MDM_CHANNELS(STATS_ENTRY)
+};
+
+/* Protects the counters, held for a few instructions per publish */
+static struct k_spinlock lock;
+
+static uint32_t reset_time;
+
+static struct stats_entry *entry_find(const struct zbus_channel *chan)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (entries[i].chan == chan) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Notified before all other observers of the channel */
+static void begin_callback(const struct zbus_channel *chan)
+{
+	struct stats_entry *entry = entry_find(chan);
+
+	if (entry) {
+		entry->started = true;
+		entry->start = k_cycle_get_32();
+	}
+}
+
+ZBUS_LISTENER_DEFINE(mdm_stats_begin, begin_callback);
+
+/* Notified after all static observers of the channel */
+static void end_callback(const struct zbus_channel *chan)
+{
+	uint32_t end = k_cycle_get_32();
+	struct stats_entry *entry = entry_find(chan);
+	k_spinlock_key_t key;
+
+	if (!entry) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	entry->pubs++;
+
+	/* Channels defined outside of mdm_channels.h do not have the first listener */
+	if (entry->started) {
+		uint32_t cycles = end - entry->start;
+
+		entry->obs_cycles_total += cycles;
+		entry->obs_cycles_max = MAX(entry->obs_cycles_max, cycles);
+		entry->started = false;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+ZBUS_LISTENER_DEFINE(mdm_stats_end, end_callback);
+
+void mdm_stats_pub_failed(const struct zbus_channel *chan, int err)
+{
+	struct stats_entry *entry;
+	k_spinlock_key_t key;
+
+	if (err != -EAGAIN && err != -EBUSY) {
+		return;
+	}
+
+	entry = entry_find(chan);
+	if (!entry) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	entry->pub_timeouts++;
+	k_spin_unlock(&lock, key);
+}
+
+static void snapshot(const struct stats_entry *entry, struct mdm_stats_msg *msg)
+{
+	uint64_t obs_cycles_total;
+	uint32_t obs_cycles_max;
+	k_spinlock_key_t key;
+
+	*msg = (struct mdm_stats_msg){
+		.id = entry->id,
+	};
+
+	key = k_spin_lock(&lock);
+	msg->period_ms = k_uptime_get_32() - reset_time;
+	msg->pubs = entry->pubs;
+	msg->pub_timeouts = entry->pub_timeouts;
+	obs_cycles_total = entry->obs_cycles_total;
+	obs_cycles_max = entry->obs_cycles_max;
+	k_spin_unlock(&lock, key);
+
+	if (msg->pubs > 0) {
+		msg->obs_us_avg = (uint32_t)k_cyc_to_us_floor64(obs_cycles_total / msg->pubs);
+	}
+
+	msg->obs_us_max = (uint32_t)k_cyc_to_us_floor64(obs_cycles_max);
+
+#if defined(CONFIG_MDM_LINK)
+	struct mdm_link_chan_stats link;
+
+	if (mdm_link_chan_stats_get(entry->chan, &link) == 0) {
+		uint32_t records = link.records - entry->link_base.records;
+
+		if (link.tx) {
+			msg->link_tx = records;
+		} else {
+			msg->link_rx = records;
+		}
+
+		msg->link_errors = link.errors - entry->link_base.errors;
+	}
+#endif /* CONFIG_MDM_LINK */
+}
+
+int mdm_stats_get(const struct zbus_channel *chan, struct mdm_stats_msg *stats)
+{
+	const struct stats_entry *entry = entry_find(chan);
+
+	if (!entry) {
+		return -ENOENT;
+	}
+
+	snapshot(entry, stats);
+
+	return 0;
+}
+
+int mdm_stats_remote_get(const struct zbus_channel *chan, struct mdm_stats_msg *stats)
+{
+	const struct stats_entry *entry = entry_find(chan);
+	k_spinlock_key_t key;
+	int err = 0;
+
+	if (!entry) {
+		return -ENOENT;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (entry->remote_valid) {
+		*stats = entry->remote;
+	} else {
+		err = -ENODATA;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return err;
+}
+
+const struct zbus_channel *mdm_stats_chan_get(size_t index)
+{
+	return (index < ARRAY_SIZE(entries)) ? entries[index].chan : NULL;
+}
+
+void mdm_stats_reset(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct stats_entry *entry = &entries[i];
+		k_spinlock_key_t key;
+
+#if defined(CONFIG_MDM_LINK)
+		(void)mdm_link_chan_stats_get(entry->chan, &entry->link_base);
+#endif
+
+		key = k_spin_lock(&lock);
+		entry->pubs = 0;
+		entry->pub_timeouts = 0;
+		entry->obs_cycles_total = 0;
+		entry->obs_cycles_max = 0;
+		k_spin_unlock(&lock, key);
+	}
+
+	reset_time = k_uptime_get_32();
+}
+
+#if defined(CONFIG_MDM_STATS_PUBLISH) && defined(CONFIG_MDM_RUNNER_DOMAIN)
+
+/* The runner publishes its statistics to the controller */
+MDM_CHANNELS_DEFINE(MDM_STATS_CHANNELS, RUNNER)
+
+static struct k_work_delayable publish_work;
+
+static void publish_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct mdm_stats_msg msg;
+		int err;
+
+		snapshot(&entries[i], &msg);
+
+		err = zbus_chan_pub(&MDM_STATS_CHAN, &msg, STATS_PUB_TIMEOUT);
+		if (err) {
+			LOG_WRN("zbus_chan_pub, error: %d", err);
+			mdm_stats_pub_failed(&MDM_STATS_CHAN, err);
+			break;
+		}
+	}
+
+	(void)k_work_reschedule(&publish_work, K_MSEC(CONFIG_MDM_STATS_INTERVAL_MS));
+}
+
+#elif defined(CONFIG_MDM_STATS_PUBLISH)
+
+/* The controller keeps the latest statistics of every channel of the runner */
+MDM_CHANNELS_DEFINE(MDM_STATS_CHANNELS, CONTROLLER)
+
+static void remote_callback(const struct zbus_channel *chan)
+{
+	const struct mdm_stats_msg *msg = zbus_chan_const_msg(chan);
+	k_spinlock_key_t key;
+
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		struct stats_entry *entry = &entries[i];
+
+		if (entry->id != msg->id) {
+			continue;
+		}
+
+		key = k_spin_lock(&lock);
+		entry->remote = *msg;
+		entry->remote_valid = true;
+		k_spin_unlock(&lock, key);
+
+		return;
+	}
+
+	LOG_DBG("No channel for statistics of record id %u", msg->id);
+}
+
+ZBUS_LISTENER_DEFINE(mdm_stats_remote, remote_callback);
+ZBUS_CHAN_ADD_OBS(MDM_STATS_CHAN, mdm_stats_remote, 0);
+
+#endif /* CONFIG_MDM_STATS_PUBLISH */
+
+static int mdm_stats_init(void)
+{
+	int err;
+
+	reset_time = k_uptime_get_32();
+
+	/* Runtime observers are notified after all static observers */
+	for (size_t i = 0; i < ARRAY_SIZE(entries); i++) {
+		err = zbus_chan_add_obs(entries[i].chan, &mdm_stats_end, ADD_OBS_TIMEOUT);
+		if (err) {
+			LOG_ERR("Cannot count %s, error: %d", zbus_chan_name(entries[i].chan), err);
+		}
+	}
+
+#if defined(CONFIG_MDM_STATS_PUBLISH) && defined(CONFIG_MDM_RUNNER_DOMAIN)
+	k_work_init_delayable(&publish_work, publish_work_handler);
+	(void)k_work_schedule(&publish_work, K_MSEC(CONFIG_MDM_STATS_INTERVAL_MS));
+#endif
+
+	return 0;
+}
+
+SYS_INIT(mdm_stats_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Per-channel statistics.
+ *
+ * Counts the publishes of every module channel and times the notification of its observers
+ * with the cycle counter: a listener notified before all other observers takes the start
+ * time, and a runtime observer, which zbus notifies after all static observers, the end
+ * time. Listeners are timed while they run, subscribers only while their message is queued.
+ * The link counters of each channel and the publish timeouts reported by its publishers
+ * complete the picture.
+ *
+ * The runner domain publishes its statistics on MDM_STATS_CHAN, one message per channel, so
+ * the controller domain can show both sides with mdm_stats_remote_get() or the zbus stats
+ * shell command.
+ */
+
+#ifndef MDM_STATS_H__
+#define MDM_STATS_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Channel carrying the statistics of the runner domain */
+ZBUS_CHAN_DECLARE(MDM_STATS_CHAN);
+
+/* Channel list, see mdm_channels.h */
+#define MDM_STATS_CHANNELS(X)									\
+	X(MDM_STATS_CHAN, struct mdm_stats_msg, RUNNER, MDM_STATS_NODE, MDM_LINK_ID_STATS,	\
+	  NULL, MDM_LINK_LANE_DEFAULT, 0)
+
+/* Listener notified first on every module channel, see mdm_channels.h */
+ZBUS_OBS_DECLARE(mdm_stats_begin);
+
+/** Statistics of one channel, also the message of MDM_STATS_CHAN */
+struct mdm_stats_msg {
+	/** Link record identifier of the channel, see @ref mdm_link_chan_id */
+	uint8_t id;
+
+	/** Milliseconds covered by the counters, since boot or the last mdm_stats_reset() */
+	uint32_t period_ms;
+
+	/** Publishes whose observers were notified */
+	uint32_t pubs;
+
+	/** Publishes that failed because the channel could not be claimed or locked in time */
+	uint32_t pub_timeouts;
+
+	/** Average time taken to notify the observers, in microseconds */
+	uint32_t obs_us_avg;
+
+	/** Longest time taken to notify the observers, in microseconds */
+	uint32_t obs_us_max;
+
+	/** Records sent over the link */
+	uint32_t link_tx;
+
+	/** Records received over the link */
+	uint32_t link_rx;
+
+	/** Records that could not be encoded, or received records that could not be published */
+	uint32_t link_errors;
+};
+
+#if defined(CONFIG_MDM_STATS)
+
+/**
+ * @brief Count a failed publish of a channel.
+ *
+ * Called by publishers when zbus_chan_pub(), zbus_chan_claim() or zbus_chan_notify() fails.
+ * Only -EAGAIN and -EBUSY are counted as timeouts, other errors are ignored.
+ *
+ * @param chan Channel that could not be published.
+ * @param err Error returned by zbus.
+ */
+void mdm_stats_pub_failed(const struct zbus_channel *chan, int err);
+
+/**
+ * @brief Get the statistics of a channel of this domain.
+ *
+ * @param chan Module channel.
+ * @param stats Filled with the channel's statistics.
+ *
+ * @return 0 on success, -ENOENT if the channel is not a module channel.
+ */
+int mdm_stats_get(const struct zbus_channel *chan, struct mdm_stats_msg *stats);
+
+/**
+ * @brief Get the latest statistics of a channel received from the runner domain.
+ *
+ * @param chan Module channel.
+ * @param stats Filled with the channel's statistics.
+ *
+ * @retval 0 On success.
+ * @retval -ENOENT The channel is not a module channel.
+ * @retval -ENODATA No statistics of the channel were received yet.
+ */
+int mdm_stats_remote_get(const struct zbus_channel *chan, struct mdm_stats_msg *stats);
+
+/**
+ * @brief Restart the statistics of all channels of this domain.
+ */
+void mdm_stats_reset(void);
+
+/**
+ * @brief Go through the channels with statistics.
+ *
+ * @param index Position of the channel, starting at 0.
+ *
+ * @return Channel, or NULL if @p index is past the last channel.
+ */
+const struct zbus_channel *mdm_stats_chan_get(size_t index);
+
+#else
+
+static inline void mdm_stats_pub_failed(const struct zbus_channel *chan, int err)
+{
+	ARG_UNUSED(chan);
+	ARG_UNUSED(err);
+}
+
+#endif /* CONFIG_MDM_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_STATS_H__ */
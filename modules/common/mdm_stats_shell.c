@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "mdm_stats.h"
+
+#if defined(CONFIG_MDM_MSG_POOL)
+#include "mdm_msg_pool.h"
+#endif
+
+typedef int (*stats_get_t)(const struct zbus_channel *chan, struct mdm_stats_msg *stats);
+
+static void stats_print(const struct shell *sh, stats_get_t get)
+{
+	const struct zbus_channel *chan;
+
+	shell_print(sh, "%-24s %8s %8s %8s %8s %8s %8s %8s %8s", "channel", "pubs", "pubs/s",
+		    "timeouts", "obs avg", "obs max", "link tx", "link rx", "link err");
+
+	for (size_t i = 0; (chan = mdm_stats_chan_get(i)) != NULL; i++) {
+		struct mdm_stats_msg stats;
+		uint32_t rate;
+
+		if (get(chan, &stats)) {
+			continue;
+		}
+
+		/* Tenths of publishes per second */
+		rate = (uint32_t)((uint64_t)stats.pubs * 10 * MSEC_PER_SEC / MAX(stats.period_ms, 1));
+
+		shell_print(sh, "%-24s %8u %6u.%u %8u %5u us %5u us %8u %8u %8u",
+			    zbus_chan_name(chan), stats.pubs, rate / 10, rate % 10,
+			    stats.pub_timeouts, stats.obs_us_avg, stats.obs_us_max, stats.link_tx,
+			    stats.link_rx, stats.link_errors);
+	}
+}
+
+#if defined(CONFIG_MDM_MSG_POOL)
+static void pool_print(const struct shell *sh)
+{
+	struct mdm_msg_pool_stats pool;
+
+	mdm_msg_pool_stats_get(&pool);
+
+	shell_print(sh, "\nMessage pool: %u/%u buffers of %u bytes in use, peak %u, full %u times",
+		    pool.in_use, pool.count, (uint32_t)MDM_MSG_POOL_BUF_SIZE, pool.peak, pool.full);
+}
+#endif /* CONFIG_MDM_MSG_POOL */
+
+static bool remote_available(void)
+{
+	const struct zbus_channel *chan;
+
+	for (size_t i = 0; (chan = mdm_stats_chan_get(i)) != NULL; i++) {
+		struct mdm_stats_msg stats;
+
+		if (mdm_stats_remote_get(chan, &stats) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	stats_print(sh, mdm_stats_get);
+
+#if defined(CONFIG_MDM_MSG_POOL)
+	pool_print(sh);
+#endif
+
+	if (remote_available()) {
+		shell_print(sh, "\nRunner domain:");
+		stats_print(sh, mdm_stats_remote_get);
+	}
+
+	return 0;
+}
+
+static int cmd_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	mdm_stats_reset();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_zbus_stats,
+	SHELL_CMD(reset, NULL, "Restart the statistics of this domain", cmd_stats_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_zbus,
+	SHELL_CMD(stats, &sub_zbus_stats, "Print the statistics of the module channels",
+		  cmd_stats),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(zbus, &sub_zbus, "zbus channels", NULL);
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
+
+#include "mdm_time.h"
+#include "mdm_link.h"
+#include "mdm_channels.h"
+#include "mdm_stats.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mdm_time, CONFIG_MDM_TIME_SYNC_LOG_LEVEL);
+
+#ifndef MDM_TIME_SYNC_NODE
+#error "MDM_TIME_SYNC_NODE must be defined to use cross-domain clock synchronization"
+#endif
+
+/* Drift samples beyond this are measurement errors, such as an offset outlier or a restart of
+ * the runner, and are discarded
+ */
+#define DRIFT_PPB_MAX 1000000
+
+/* Weight of a new drift sample is 1 / DRIFT_FILTER */
+#define DRIFT_FILTER 4
+
+#define NSEC_PER_SEC_LL 1000000000LL
+
+static struct k_spinlock lock;
+static struct mdm_time_sync_status status;
+
+/* Runner time at controller time c */
+static int64_t model_forward(const struct mdm_time_sync_status *s, int64_t c)
+{
+	return c + s->offset_us + (c - s->ref_us) * s->drift_ppb / NSEC_PER_SEC_LL;
+}
+
+/* Controller time at runner time r, to first order in the drift */
+static int64_t model_inverse(const struct mdm_time_sync_status *s, int64_t r)
+{
+	int64_t c = r - s->offset_us;
+
+	return c - (c - s->ref_us) * s->drift_ppb / NSEC_PER_SEC_LL;
+}
+
+static int convert(int64_t in, int64_t *out, bool to_runner)
+{
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (!status.synced) {
+		ret = -EAGAIN;
+	} else if (to_runner) {
+		*out = model_forward(&status, in);
+	} else {
+		*out = model_inverse(&status, in);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+int mdm_time_to_local(int64_t remote_us, int64_t *local_us)
+{
+	/* The runner's local time is runner time */
+	return convert(remote_us, local_us, IS_ENABLED(CONFIG_MDM_RUNNER_DOMAIN));
+}
+
+int mdm_time_to_remote(int64_t local_us, int64_t *remote_us)
+{
+	return convert(local_us, remote_us, !IS_ENABLED(CONFIG_MDM_RUNNER_DOMAIN));
+}
+
+void mdm_time_sync_status_get(struct mdm_time_sync_status *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*out = status;
+
+	k_spin_unlock(&lock, key);
+}
+
+#if defined(CONFIG_MDM_RUNNER_DOMAIN)
+
+/* The runner answers the requests of the controller */
+MDM_CHANNELS_DEFINE(MDM_TIME_CHANNELS, RUNNER)
+
+/* Called in the receive context of the proxy agent or link */
+static void req_callback(const struct zbus_channel *chan)
+{
+	int64_t t2 = mdm_time_now_us();
+	const struct mdm_time_req *req = zbus_chan_const_msg(chan);
+	struct mdm_time_resp *resp;
+	k_spinlock_key_t key;
+	int err;
+
+	key = k_spin_lock(&lock);
+	status = req->estimate;
+	k_spin_unlock(&lock, key);
+
+	/* Not waiting, the receive context must not block on this domain's publishers */
+	err = zbus_chan_claim(&MDM_TIME_RESP_CHAN, K_NO_WAIT);
+	if (err) {
+		LOG_WRN("Cannot answer request %u, error: %d", req->seq, err);
+		mdm_stats_pub_failed(&MDM_TIME_RESP_CHAN, err);
+		return;
+	}
+
+	resp = zbus_chan_msg(&MDM_TIME_RESP_CHAN);
+	resp->seq = req->seq;
+	resp->t1 = req->t1;
+	resp->t2 = t2;
+	resp->t3 = mdm_time_now_us();
+
+	(void)zbus_chan_finish(&MDM_TIME_RESP_CHAN);
+
+	err = zbus_chan_notify(&MDM_TIME_RESP_CHAN, K_NO_WAIT);
+	if (err) {
+		LOG_WRN("zbus_chan_notify, error: %d", err);
+		mdm_stats_pub_failed(&MDM_TIME_RESP_CHAN, err);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(mdm_time_req_listener, req_callback);
+ZBUS_CHAN_ADD_OBS(MDM_TIME_REQ_CHAN, mdm_time_req_listener, 0);
+
+#else
+
+/* The controller runs the synchronization rounds */
+MDM_CHANNELS_DEFINE(MDM_TIME_CHANNELS, CONTROLLER)
+
+/* Exchanges of the current round, protected by the lock */
+static struct {
+	uint32_t seq;
+	int64_t t1;
+	uint8_t sent;
+
+	/* Exchange with the shortest round trip so far */
+	bool valid;
+	uint32_t rtt_us;
+	int64_t offset_us;
+	int64_t local_us;
+} round;
+
+/* Drift samples taken into the estimate, protected by the lock */
+static uint32_t drift_samples;
+
+static struct k_work_delayable sync_work;
+
+/* Called in the receive context of the proxy agent or link */
+static void resp_callback(const struct zbus_channel *chan)
+{
+	int64_t t4 = mdm_time_now_us();
+	const struct mdm_time_resp *resp = zbus_chan_const_msg(chan);
+	int64_t rtt;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+
+	/* Responses arriving after the next request was sent are ignored */
+	if (resp->seq != round.seq || resp->t1 != round.t1) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	/* Round trip without the time the runner took to answer */
+	rtt = (t4 - resp->t1) - (resp->t3 - resp->t2);
+
+	if (rtt >= 0 && (!round.valid || rtt < round.rtt_us)) {
+		round.valid = true;
+		round.rtt_us = (uint32_t)MIN(rtt, UINT32_MAX);
+		round.offset_us = ((resp->t2 - resp->t1) + (resp->t3 - t4)) / 2;
+		round.local_us = resp->t1 + (t4 - resp->t1) / 2;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+ZBUS_LISTENER_DEFINE(mdm_time_resp_listener, resp_callback);
+ZBUS_CHAN_ADD_OBS(MDM_TIME_RESP_CHAN, mdm_time_resp_listener, 0);
+
+/* Update the estimate from the best exchange of a round. Must be called with the lock held. */
+static void round_complete(void)
+{
+	if (status.synced) {
+		int64_t dt = round.local_us - status.ref_us;
+
+		if (dt > 0) {
+			int64_t sample;
+
+			sample = (round.offset_us - status.offset_us) * NSEC_PER_SEC_LL / dt;
+
+			/* The offset is still updated, it is measured directly. The first drift
+			 * sample is taken as is, later ones are filtered.
+			 */
+			if (sample < -DRIFT_PPB_MAX || sample > DRIFT_PPB_MAX) {
+				LOG_DBG("Discarding drift sample of %lld ppb", (long long)sample);
+			} else if (drift_samples++ == 0) {
+				status.drift_ppb = sample;
+			} else {
+				status.drift_ppb += (sample - status.drift_ppb) / DRIFT_FILTER;
+			}
+		}
+	}
+
+	status.synced = true;
+	status.ref_us = round.local_us;
+	status.offset_us = round.offset_us;
+	status.rtt_us = round.rtt_us;
+	status.rounds++;
+}
+
+static int req_send(void)
+{
+	int err;
+	struct mdm_time_req *req;
+	k_spinlock_key_t key;
+
+	err = zbus_chan_claim(&MDM_TIME_REQ_CHAN, K_MSEC(CONFIG_MDM_TIME_SYNC_BURST_SPACING_MS));
+	if (err) {
+		LOG_ERR("zbus_chan_claim, error: %d", err);
+		mdm_stats_pub_failed(&MDM_TIME_REQ_CHAN, err);
+		return err;
+	}
+
+	req = zbus_chan_msg(&MDM_TIME_REQ_CHAN);
+
+	key = k_spin_lock(&lock);
+	req->seq = ++round.seq;
+	req->estimate = status;
+	req->t1 = mdm_time_now_us();
+	round.t1 = req->t1;
+	k_spin_unlock(&lock, key);
+
+	(void)zbus_chan_finish(&MDM_TIME_REQ_CHAN);
+
+	err = zbus_chan_notify(&MDM_TIME_REQ_CHAN, K_MSEC(CONFIG_MDM_TIME_SYNC_BURST_SPACING_MS));
+	if (err) {
+		LOG_ERR("zbus_chan_notify, error: %d", err);
+		mdm_stats_pub_failed(&MDM_TIME_REQ_CHAN, err);
+	}
+
+	return err;
+}
+
+static void sync_work_handler(struct k_work *work)
+{
+	struct mdm_time_sync_status current;
+	k_spinlock_key_t key;
+	bool round_done = false;
+	bool completed = false;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&lock);
+
+	if (round.sent == CONFIG_MDM_TIME_SYNC_BURST) {
+		round_done = true;
+
+		if (round.valid) {
+			round_complete();
+			completed = true;
+		}
+
+		round.sent = 0;
+		round.valid = false;
+
+		/* Invalidate late responses of the finished round */
+		round.seq++;
+	} else {
+		round.sent++;
+	}
+
+	current = status;
+
+	k_spin_unlock(&lock, key);
+
+	if (completed) {
+		LOG_DBG("Offset %lld us, drift %d ppb, rtt %u us", (long long)current.offset_us,
+			current.drift_ppb, current.rtt_us);
+	}
+
+	if (round_done) {
+		uint32_t delay_ms = CONFIG_MDM_TIME_SYNC_INTERVAL_MS;
+
+		/* Retry sooner while the runner has not answered yet */
+		if (!current.synced) {
+			delay_ms = MIN(delay_ms, MSEC_PER_SEC);
+		}
+
+		(void)k_work_reschedule(&sync_work, K_MSEC(delay_ms));
+		return;
+	}
+
+	(void)req_send();
+
+	(void)k_work_reschedule(&sync_work, K_MSEC(CONFIG_MDM_TIME_SYNC_BURST_SPACING_MS));
+}
+
+static int mdm_time_init(void)
+{
+	k_work_init_delayable(&sync_work, sync_work_handler);
+	(void)k_work_schedule(&sync_work, K_NO_WAIT);
+
+	return 0;
+}
+
+SYS_INIT(mdm_time_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#endif /* CONFIG_MDM_RUNNER_DOMAIN */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Cross-domain clock synchronization.
+ *
+ * The controller periodically sends a burst of requests that the runner answers with its
+ * receive and send times. From the exchange with the shortest round trip the controller
+ * estimates the offset of the runner's clock, and from consecutive rounds its drift. The
+ * controller shares its estimate in every request, so both domains can convert timestamps
+ * taken by the other one.
+ *
+ * Times are microseconds since boot of the respective domain, see mdm_time_now_us().
+ * Message timestamps in milliseconds, such as those from k_uptime_get_32(), are converted
+ * after multiplying them by USEC_PER_MSEC.
+ */
+
+#ifndef MDM_TIME_H__
+#define MDM_TIME_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Channels used for the exchanges. The controller owns the request channel. */
+ZBUS_CHAN_DECLARE(MDM_TIME_REQ_CHAN, MDM_TIME_RESP_CHAN);
+
+/* Channel list, see mdm_channels.h. The runner domain answers the requests of the controller.
+ * Both are sent on the highest priority lane, batching delays would skew the estimate.
+ */
+#define MDM_TIME_CHANNELS(X)									\
+	X(MDM_TIME_REQ_CHAN, struct mdm_time_req, CONTROLLER, MDM_TIME_SYNC_NODE,		\
+	  MDM_LINK_ID_TIME_REQ, NULL, 0, 0)							\
+	X(MDM_TIME_RESP_CHAN, struct mdm_time_resp, RUNNER, MDM_TIME_SYNC_NODE,			\
+	  MDM_LINK_ID_TIME_RESP, NULL, 0, 0)
+
+/** Synchronization response, sent by the runner */
+struct mdm_time_resp {
+	/** Sequence number and t1 of the request */
+	uint32_t seq;
+	int64_t t1;
+
+	/** Runner time when the request was received */
+	int64_t t2;
+
+	/** Runner time when the response was sent */
+	int64_t t3;
+};
+
+/** Current estimate of the relation between the two clocks */
+struct mdm_time_sync_status {
+	/** True once a round completed, the conversion functions fail until then */
+	bool synced;
+
+	/** Controller time of the last completed round */
+	int64_t ref_us;
+
+	/** Runner time minus controller time at ref_us */
+	int64_t offset_us;
+
+	/** Rate of the runner's clock relative to the controller's, in parts per billion */
+	int32_t drift_ppb;
+
+	/** Round trip of the exchange the estimate is based on */
+	uint32_t rtt_us;
+
+	/** Completed rounds */
+	uint32_t rounds;
+};
+
+/** Synchronization request, sent by the controller */
+struct mdm_time_req {
+	uint32_t seq;
+
+	/** Controller time when the request was sent */
+	int64_t t1;
+
+	/** Controller's current estimate, shared with the runner */
+	struct mdm_time_sync_status estimate;
+};
+
+/**
+ * @brief Get the local time used for synchronization.
+ *
+ * @return Microseconds since boot, with the resolution of the cycle counter where available.
+ */
+static inline int64_t mdm_time_now_us(void)
+{
+#if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+	return k_cyc_to_us_floor64(k_cycle_get_64());
+#else
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+#endif
+}
+
+/**
+ * @brief Convert a time of the other domain to local time.
+ *
+ * @param remote_us Time of the other domain, in microseconds since its boot.
+ * @param local_us Set to the corresponding local time.
+ *
+ * @retval 0 On success.
+ * @retval -EAGAIN The clocks are not synchronized yet.
+ */
+int mdm_time_to_local(int64_t remote_us, int64_t *local_us);
+
+/**
+ * @brief Convert a local time to the time of the other domain.
+ *
+ * @param local_us Local time, in microseconds since boot.
+ * @param remote_us Set to the corresponding time of the other domain.
+ *
+ * @retval 0 On success.
+ * @retval -EAGAIN The clocks are not synchronized yet.
+ */
+int mdm_time_to_remote(int64_t local_us, int64_t *remote_us);
+
+/**
+ * @brief Get the current synchronization estimate.
+ *
+ * On the runner this is the estimate last shared by the controller.
+ *
+ * @param status Filled with the estimate.
+ */
+void mdm_time_sync_status_get(struct mdm_time_sync_status *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_TIME_H__ */
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "mdm_zbus_log.h"
+#include "mdm_channels.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mdm_zbus_log, CONFIG_MDM_ZBUS_LOG_LOG_LEVEL);
+
+/* Largest message that is logged, the buffer the logging thread formats from */
+#define MSG_SIZE_MAX MAX(MDM_CHANNELS_MSG_SIZE_MAX, 1)
+
+/* Header in front of every message in the ring buffer */
+struct record_hdr {
+	const struct mdm_zbus_log_chan *entry;
+	uint32_t time;
+	uint16_t len;
+};
+
+RING_BUF_DECLARE(log_ring, CONFIG_MDM_ZBUS_LOG_BUFFER_SIZE);
+
+/* Serializes publishers of different channels writing to the ring buffer */
+static struct k_spinlock lock;
+
+static K_SEM_DEFINE(log_sem, 0, 1);
+
+static atomic_t dropped;
+
+uint32_t mdm_zbus_log_dropped_get(void)
+{
+	return (uint32_t)atomic_get(&dropped);
+}
+
+static const struct mdm_zbus_log_chan *entry_find(const struct zbus_channel *chan)
+{
+	STRUCT_SECTION_FOREACH(mdm_zbus_log_chan, entry) {
+		if (entry->chan == chan) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Called in the publisher's context, only copies the message */
+static void log_callback(const struct zbus_channel *chan)
+{
+	struct record_hdr hdr = {
+		.entry = entry_find(chan),
+		.time = k_uptime_get_32(),
+	};
+	size_t len = zbus_chan_msg_size(chan);
+	k_spinlock_key_t key;
+	bool stored = false;
+
+	if (hdr.entry == NULL || len > MSG_SIZE_MAX) {
+		(void)atomic_inc(&dropped);
+		return;
+	}
+
+	hdr.len = (uint16_t)len;
+
+	key = k_spin_lock(&lock);
+
+	if (ring_buf_space_get(&log_ring) >= sizeof(hdr) + hdr.len) {
+		(void)ring_buf_put(&log_ring, (const uint8_t *)&hdr, sizeof(hdr));
+		(void)ring_buf_put(&log_ring, zbus_chan_const_msg(chan), hdr.len);
+		stored = true;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (!stored) {
+		(void)atomic_inc(&dropped);
+		return;
+	}
+
+	k_sem_give(&log_sem);
+}
+
+ZBUS_LISTENER_DEFINE(mdm_zbus_log, log_callback);
+
+/* Take the next record out of the ring buffer. Returns false if it is empty. */
+static bool record_get(struct record_hdr *hdr, uint8_t *msg)
+{
+	bool found = false;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Records are put as a whole, so a header is always followed by its message */
+	if (ring_buf_get(&log_ring, (uint8_t *)hdr, sizeof(*hdr)) == sizeof(*hdr)) {
+		(void)ring_buf_get(&log_ring, msg, hdr->len);
+		found = true;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return found;
+}
+
+static void mdm_zbus_log_thread(void *p1, void *p2, void *p3)
+{
+	static uint8_t msg[MSG_SIZE_MAX] __aligned(8);
+	uint32_t reported = 0;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		struct record_hdr hdr;
+		uint32_t lost;
+
+		(void)k_sem_take(&log_sem, K_FOREVER);
+
+		while (record_get(&hdr, msg)) {
+			hdr.entry->format(msg, hdr.time);
+		}
+
+		lost = mdm_zbus_log_dropped_get();
+		if (lost != reported) {
+			LOG_WRN("%u messages not logged", lost - reported);
+			reported = lost;
+		}
+	}
+}
+
+K_THREAD_DEFINE(mdm_zbus_log_tid, CONFIG_MDM_ZBUS_LOG_THREAD_STACK_SIZE, mdm_zbus_log_thread,
+		NULL, NULL, NULL, CONFIG_MDM_ZBUS_LOG_THREAD_PRIORITY, 0, 0);
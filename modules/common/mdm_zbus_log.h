@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Deferred logging of channel messages.
+ *
+ * A shared listener copies every message of the registered channels into a ring buffer,
+ * which is all the publisher pays for. A low priority thread formats the messages later
+ * with the formatter of their channel, so traffic logging does not delay zbus_chan_pub() on
+ * the Bluetooth RX path or in the receive thread of the proxy agent. Messages that do not fit
+ * in the buffer are dropped and counted.
+ */
+
+#ifndef MDM_ZBUS_LOG_H__
+#define MDM_ZBUS_LOG_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Format a logged message.
+ *
+ * Called in the logging thread with a copy of the message.
+ *
+ * @param msg Message as published.
+ * @param time Uptime in milliseconds when the message was published.
+ */
+typedef void (*mdm_zbus_log_format_t)(const void *msg, uint32_t time);
+
+/** Channel logged by the shared listener */
+struct mdm_zbus_log_chan {
+	const struct zbus_channel *chan;
+	mdm_zbus_log_format_t format;
+};
+
+/* Listener copying the messages of logged channels into the buffer */
+ZBUS_OBS_DECLARE(mdm_zbus_log);
+
+/**
+ * @brief Log the messages of a channel.
+ *
+ * The shared listener is added after the other observers of the channel.
+ *
+ * @param _chan Channel to log.
+ * @param _format Formatter of the channel's messages, see @ref mdm_zbus_log_format_t.
+ */
+#define MDM_ZBUS_LOG_CHAN_ADD(_chan, _format)							\
+	const STRUCT_SECTION_ITERABLE(mdm_zbus_log_chan, _CONCAT(_mdm_zbus_log_, _chan)) = {	\
+		.chan = &_chan,									\
+		.format = _format,								\
+	};											\
+	ZBUS_CHAN_ADD_OBS(_chan, mdm_zbus_log, 99)
+
+/**
+ * @brief Get the number of messages that were not logged.
+ *
+ * Messages are dropped when the buffer is full or when they are larger than the largest
+ * message of the module channels.
+ *
+ * @return Dropped messages since boot.
+ */
+uint32_t mdm_zbus_log_dropped_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MDM_ZBUS_LOG_H__ */
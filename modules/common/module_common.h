@@ -51,6 +51,12 @@ extern "C" {
 					MAX(MAX_8(a1, a2, a3, a4, a5, a6, a7, a8), a9)
 #define MAX_10(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) \
 					MAX(MAX_9(a1, a2, a3, a4, a5, a6, a7, a8, a9), a10)
+#define MAX_11(a1, ...)			MAX(a1, MAX_10(__VA_ARGS__))
+#define MAX_12(a1, ...)			MAX(a1, MAX_11(__VA_ARGS__))
+#define MAX_13(a1, ...)			MAX(a1, MAX_12(__VA_ARGS__))
+#define MAX_14(a1, ...)			MAX(a1, MAX_13(__VA_ARGS__))
+#define MAX_15(a1, ...)			MAX(a1, MAX_14(__VA_ARGS__))
+#define MAX_16(a1, ...)			MAX(a1, MAX_15(__VA_ARGS__))
 
 #define SELECT_MAX_N(N)			CONCAT(MAX_, N)
 
@@ -67,10 +73,11 @@ extern "C" {
  *
  * @param _chan Channel to compute the size of the type for.
  * @param _type Type to compute the size of.
+ * @param ... Further arguments of the list entry, ignored.
  *
  * @return Size of the type.
  */
-#define SIZE_OF_TYPE(_chan, _type)	sizeof(_type),
+#define SIZE_OF_TYPE(_chan, _type, ...)	sizeof(_type),
 
 /**
  * @brief Macro to compute the maximum message size from a list of channel date types.
@@ -80,7 +87,7 @@ extern "C" {
  *	  Example: MAX_N(sizeof(struct cloud_msg), sizeof(enum fota_msg_type), 0)
 
  * @param _CHAN_LIST List of channels to compute the maximum message size from.
- *		     The list should be in the format: (CHANNEL_NAME, type)
+ *		     The list should be in the format: (CHANNEL_NAME, type, ...)
  *
  * @return Maximum message size from the list of channels
  */
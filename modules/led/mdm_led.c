@@ -13,6 +13,10 @@
 
 #include "module_common.h"
 #include "mdm_led.h"
+#include "mdm_link.h"
+#include "mdm_channels.h"
+#include "mdm_zbus_log.h"
+#include "mdm_health.h"
 
 /* Use GPIO LEDs available on nRF54L15DK */
 #define LED1 DT_ALIAS(led1)
@@ -40,14 +44,7 @@ LOG_MODULE_REGISTER(led, CONFIG_MDM_LED_LOG_LEVEL);
 
 /* This file is for the runner side: the controller has the main channel, and the
  * runner has the shadow channel */
-ZBUS_SHADOW_CHAN_DEFINE(
-	LED_CHAN,
-	struct led_msg,
-	MDM_LED_PROXY_NODE,
-	NULL,
-	ZBUS_OBSERVERS_EMPTY,
-	ZBUS_MSG_INIT(0)
-);
+MDM_CHANNELS_DEFINE(MDM_LED_CHANNELS, RUNNER)
 
 static void led_callback(const struct zbus_channel *chan);
 
@@ -214,15 +211,25 @@ static int led_init(void)
 	return 0;
 }
 
+static int led_module_init(void)
+{
+	int err = led_init();
+
+	mdm_health_module_status_set(MDM_HEALTH_MODULE_LED, err);
+
+	return err;
+}
+
 /* Initialize module at SYS_INIT() */
-SYS_INIT(led_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+SYS_INIT(led_module_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
 
 #if IS_ENABLED(CONFIG_MDM_LED_ZBUS_LOGGING)
 
-static void log_led_message(const struct zbus_channel *chan)
+/* Called in the logging thread */
+static void log_led_message(const void *message, uint32_t time)
 {
-	const struct led_msg *msg = zbus_chan_const_msg(chan);
-	LOG_INF("=== LED ZBUS Message Received ===");
+	const struct led_msg *msg = message;
+	LOG_INF("=== LED ZBUS Message Received at %u ms ===", time);
 	LOG_INF("Type: %s", led_message_type_to_string(msg->type));
 	LOG_INF("R: %d, G: %d, B: %d", msg->red, msg->green, msg->blue);
 	LOG_INF("On Duration: %u ms", msg->duration_on_msec);
@@ -231,7 +238,6 @@ static void log_led_message(const struct zbus_channel *chan)
 	LOG_INF("=============================");
 }
 
-ZBUS_LISTENER_DEFINE(led_logger, log_led_message);
-ZBUS_CHAN_ADD_OBS(LED_CHAN, led_logger, 0);
+MDM_ZBUS_LOG_CHAN_ADD(LED_CHAN, log_led_message);
 
 #endif /* CONFIG_MDM_LED_ZBUS_LOGGING */
@@ -23,6 +23,18 @@ extern "C" {
 /* Channels provided by this module */
 ZBUS_CHAN_DECLARE(LED_CHAN);
 
+/* Channel list of this module, see mdm_channels.h. Periodic refreshes often repeat the current
+ * LED state, which need not cross the link, while an LED command lost on the link would not be
+ * repeated. Suppression also swallows a repeated command with a finite number of repetitions,
+ * so it is opt-in.
+ */
+#define MDM_LED_CHANNELS(X)									\
+	X(LED_CHAN, struct led_msg, CONTROLLER, MDM_LED_PROXY_NODE, MDM_LINK_ID_LED, NULL,	\
+	  CONFIG_MDM_LED_LINK_LANE,								\
+	  (IS_ENABLED(CONFIG_MDM_LED_SUPPRESS_UNCHANGED) ?					\
+	   MDM_LINK_CHAN_SUPPRESS_UNCHANGED : 0) |						\
+	  (IS_ENABLED(CONFIG_MDM_LED_RELIABLE) ? MDM_LINK_CHAN_RELIABLE : 0))
+
 enum led_msg_type {
 	LED_RGB_SET,
 };
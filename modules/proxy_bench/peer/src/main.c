@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(main, CONFIG_APP_LOG_LEVEL);
+
+int main(void)
+{
+	/* Pings are echoed by the proxy_bench module from the proxy agent's receive context */
+	LOG_INF("Proxy benchmark peer started");
+
+	return 0;
+}
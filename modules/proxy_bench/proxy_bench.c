@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
+
+#include "proxy_bench.h"
+#include "mdm_link.h"
+#include "mdm_channels.h"
+#include "mdm_stats.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(proxy_bench, CONFIG_MDM_PROXY_BENCH_LOG_LEVEL);
+
+#ifndef MDM_PROXY_BENCH_PROXY_NODE
+#error "MDM_PROXY_BENCH_PROXY_NODE must be defined to use multi-domain zbus channels"
+#endif
+
+#define PONG_TIMEOUT K_MSEC(CONFIG_MDM_PROXY_BENCH_TIMEOUT_MS)
+
+/* The runner has the ping channel, the other domain has the pong channel */
+MDM_CHANNELS_DEFINE(MDM_PROXY_BENCH_CHANNELS, RUNNER)
+
+/* Without the other domain, the link loopback answers every ping with a pong */
+MDM_LINK_LOOPBACK_MIRROR(proxy_bench, MDM_LINK_ID_PROXY_BENCH_PING, MDM_LINK_ID_PROXY_BENCH_PONG);
+
+static K_SEM_DEFINE(pong_sem, 0, 1);
+
+/* Sequence number of the ping being waited for */
+static atomic_t expected_seq;
+
+/* Round trip of the last pong, valid when pong_sem is given */
+static uint32_t pong_cycles;
+
+/* Round trips of the current run, in cycles */
+static uint32_t samples[CONFIG_MDM_PROXY_BENCH_SAMPLES];
+
+/* Called in the receive context of the proxy agent or link */
+static void pong_callback(const struct zbus_channel *chan)
+{
+	const struct proxy_bench_msg *msg = zbus_chan_const_msg(chan);
+	uint32_t now = k_cycle_get_32();
+
+	if (msg->seq != (uint32_t)atomic_get(&expected_seq)) {
+		LOG_DBG("Ignoring late pong %u", msg->seq);
+		return;
+	}
+
+	pong_cycles = now - msg->timestamp;
+	k_sem_give(&pong_sem);
+}
+
+ZBUS_LISTENER_DEFINE(proxy_bench_pong, pong_callback);
+ZBUS_CHAN_ADD_OBS(PROXY_BENCH_PONG_CHAN, proxy_bench_pong, 0);
+
+static int ping_send(uint32_t seq)
+{
+	int err;
+	struct proxy_bench_msg *msg;
+
+	err = zbus_chan_claim(&PROXY_BENCH_PING_CHAN, PONG_TIMEOUT);
+	if (err) {
+		LOG_ERR("zbus_chan_claim, error: %d", err);
+		mdm_stats_pub_failed(&PROXY_BENCH_PING_CHAN, err);
+		return err;
+	}
+
+	msg = zbus_chan_msg(&PROXY_BENCH_PING_CHAN);
+	msg->seq = seq;
+
+	for (size_t i = 0; i < sizeof(msg->data); i++) {
+		msg->data[i] = (uint8_t)(seq + i);
+	}
+
+	/* Stamped last, so filling the payload is not part of the round trip */
+	msg->timestamp = k_cycle_get_32();
+
+	(void)zbus_chan_finish(&PROXY_BENCH_PING_CHAN);
+
+	err = zbus_chan_notify(&PROXY_BENCH_PING_CHAN, PONG_TIMEOUT);
+	if (err) {
+		LOG_ERR("zbus_chan_notify, error: %d", err);
+		mdm_stats_pub_failed(&PROXY_BENCH_PING_CHAN, err);
+	}
+
+	return err;
+}
+
+/* Send a ping and wait for its pong. Returns the round trip in cycles through rtt. */
+static int round_trip(uint32_t seq, uint32_t *rtt)
+{
+	int err;
+
+	k_sem_reset(&pong_sem);
+	atomic_set(&expected_seq, seq);
+
+	err = ping_send(seq);
+	if (err) {
+		return err;
+	}
+
+	err = k_sem_take(&pong_sem, PONG_TIMEOUT);
+	if (err) {
+		return -ETIMEDOUT;
+	}
+
+	*rtt = pong_cycles;
+
+	return 0;
+}
+
+static int cycles_compare(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static inline uint32_t cyc_to_us(uint64_t cycles)
+{
+	return (uint32_t)k_cyc_to_us_floor64(cycles);
+}
+
+/* Log the statistics of a run. Sorts the samples. Returns false if a ping was lost or the 99th
+ * percentile is above CONFIG_MDM_PROXY_BENCH_P99_MAX_US.
+ */
+static bool report(uint32_t *rtt, size_t count, uint32_t lost)
+{
+	uint64_t sum = 0;
+	uint64_t jitter = 0;
+	size_t p99;
+
+	if (count == 0) {
+		LOG_WRN("No round trips completed, %u lost", lost);
+		return false;
+	}
+
+	/* Jitter is the mean difference between consecutive round trips, so it is taken
+	 * before the samples are sorted.
+	 */
+	for (size_t i = 0; i < count; i++) {
+		sum += rtt[i];
+
+		if (i > 0) {
+			jitter += (rtt[i] > rtt[i - 1]) ? rtt[i] - rtt[i - 1] : rtt[i - 1] - rtt[i];
+		}
+	}
+
+	qsort(rtt, count, sizeof(rtt[0]), cycles_compare);
+
+	/* Nearest rank */
+	p99 = DIV_ROUND_UP(count * 99, 100) - 1;
+
+	LOG_INF("%u byte payload, %zu round trips, %u lost", CONFIG_MDM_PROXY_BENCH_PAYLOAD_SIZE,
+		count, lost);
+	LOG_INF("min %u us, avg %u us, p99 %u us, max %u us, jitter %u us",
+		cyc_to_us(rtt[0]), cyc_to_us(sum / count), cyc_to_us(rtt[p99]),
+		cyc_to_us(rtt[count - 1]), cyc_to_us((count > 1) ? jitter / (count - 1) : 0));
+
+	if (CONFIG_MDM_PROXY_BENCH_P99_MAX_US > 0 &&
+	    cyc_to_us(rtt[p99]) > CONFIG_MDM_PROXY_BENCH_P99_MAX_US) {
+		LOG_ERR("p99 %u us is above the limit of %u us", cyc_to_us(rtt[p99]),
+			CONFIG_MDM_PROXY_BENCH_P99_MAX_US);
+		return false;
+	}
+
+	return lost == 0;
+}
+
+static void proxy_bench_thread(void *p1, void *p2, void *p3)
+{
+	uint32_t seq = 0;
+	uint32_t rtt;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	LOG_INF("Waiting for the other domain");
+
+	/* The other domain may start later, keep pinging until it answers */
+	while (round_trip(++seq, &rtt)) {
+	}
+
+	while (true) {
+		size_t count = 0;
+		uint32_t lost = 0;
+		bool passed;
+
+		for (size_t i = 0; i < ARRAY_SIZE(samples); i++) {
+			k_sleep(K_MSEC(CONFIG_MDM_PROXY_BENCH_INTERVAL_MS));
+
+			if (round_trip(++seq, &samples[count])) {
+				lost++;
+				continue;
+			}
+
+			count++;
+		}
+
+		passed = report(samples, count, lost);
+
+		if (CONFIG_MDM_PROXY_BENCH_P99_MAX_US > 0) {
+			if (passed) {
+				LOG_INF("Proxy benchmark passed");
+			} else {
+				LOG_ERR("Proxy benchmark failed");
+			}
+		}
+
+		if (CONFIG_MDM_PROXY_BENCH_PERIOD_S == 0) {
+			LOG_INF("Proxy benchmark done");
+			return;
+		}
+
+		k_sleep(K_SECONDS(CONFIG_MDM_PROXY_BENCH_PERIOD_S));
+	}
+}
+
+K_THREAD_DEFINE(proxy_bench_tid, CONFIG_MDM_PROXY_BENCH_THREAD_STACK_SIZE,
+		proxy_bench_thread, NULL, NULL, NULL, CONFIG_MDM_PROXY_BENCH_THREAD_PRIORITY,
+		0, 0);
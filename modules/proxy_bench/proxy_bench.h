@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**@file
+ *
+ * @brief   Proxy latency benchmark module.
+ *
+ * The runner publishes ping messages stamped with its cycle counter. The other domain
+ * publishes every ping it receives back as a pong, so the runner measures the full round
+ * trip with its own clock.
+ */
+
+#ifndef PROXY_BENCH_H__
+#define PROXY_BENCH_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Channels provided by this module */
+ZBUS_CHAN_DECLARE(PROXY_BENCH_PING_CHAN, PROXY_BENCH_PONG_CHAN);
+
+/* Channel list of this module, see mdm_channels.h. The runner has the ping channel, the other
+ * domain has the pong channel.
+ */
+#define MDM_PROXY_BENCH_CHANNELS(X)								\
+	X(PROXY_BENCH_PING_CHAN, struct proxy_bench_msg, RUNNER, MDM_PROXY_BENCH_PROXY_NODE,	\
+	  MDM_LINK_ID_PROXY_BENCH_PING, NULL, CONFIG_MDM_PROXY_BENCH_LINK_LANE, 0)		\
+	X(PROXY_BENCH_PONG_CHAN, struct proxy_bench_msg, CONTROLLER,				\
+	  MDM_PROXY_BENCH_PROXY_NODE, MDM_LINK_ID_PROXY_BENCH_PONG, NULL,			\
+	  CONFIG_MDM_PROXY_BENCH_LINK_LANE, 0)
+
+struct proxy_bench_msg {
+	/** Sequence number of the ping, echoed in the pong */
+	uint32_t seq;
+
+	/** Runner cycle count when the ping was published, echoed in the pong */
+	uint32_t timestamp;
+
+	uint8_t data[CONFIG_MDM_PROXY_BENCH_PAYLOAD_SIZE];
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROXY_BENCH_H__ */
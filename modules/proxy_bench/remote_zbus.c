@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/zbus/proxy_agent/zbus_proxy_agent.h>
+
+#include "proxy_bench.h"
+#include "mdm_link.h"
+#include "mdm_channels.h"
+#include "mdm_stats.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mdm_proxy_bench_module, CONFIG_APP_LOG_LEVEL);
+
+#ifndef MDM_PROXY_BENCH_PROXY_NODE
+#error "MDM_PROXY_BENCH_PROXY_NODE must be defined to use multi-domain zbus channels"
+#endif
+
+/* This file is for the non-runner/controller side: the runner has the ping channel, and the
+ * controller has the pong channel
+ */
+MDM_CHANNELS_DEFINE(MDM_PROXY_BENCH_CHANNELS, CONTROLLER)
+
+/* Echo every ping right away, in the receive context, so only the transport is measured */
+static void ping_callback(const struct zbus_channel *chan)
+{
+	int err;
+
+	err = zbus_chan_pub(&PROXY_BENCH_PONG_CHAN, zbus_chan_const_msg(chan), K_NO_WAIT);
+	if (err) {
+		LOG_ERR("zbus_chan_pub, error: %d", err);
+		mdm_stats_pub_failed(&PROXY_BENCH_PONG_CHAN, err);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(proxy_bench_ping, ping_callback);
+ZBUS_CHAN_ADD_OBS(PROXY_BENCH_PING_CHAN, proxy_bench_ping, 0);
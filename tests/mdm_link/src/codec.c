@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <math.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "mdm_link.h"
+#include "ble_nus.h"
+#include "channel_sounding.h"
+
+/* Same frame time on both sides, as for a record decoded from the frame it was encoded in */
+static const struct mdm_link_codec_ctx ctx = {
+	.frame_time = 100000,
+};
+
+ZTEST(mdm_codec, test_varint_round_trip)
+{
+	const uint32_t values[] = {0, 1, 127, 128, 16383, 16384, UINT32_MAX};
+	uint8_t buf[5];
+	uint32_t value;
+	int len;
+
+	for (size_t i = 0; i < ARRAY_SIZE(values); i++) {
+		len = mdm_link_varint_put(values[i], buf, sizeof(buf));
+		zassert_true(len > 0, "Cannot encode %u", values[i]);
+		zassert_equal(mdm_link_varint_get(buf, len, &value), len);
+		zassert_equal(value, values[i]);
+
+		/* Every shorter prefix misses the last byte */
+		zassert_equal(mdm_link_varint_get(buf, len - 1, &value), -EBADMSG);
+	}
+
+	zassert_equal(mdm_link_varint_put(UINT32_MAX, buf, 4), -EMSGSIZE);
+
+	/* More continuation bytes than a 32-bit value has */
+	memset(buf, 0xff, sizeof(buf));
+	zassert_equal(mdm_link_varint_get(buf, sizeof(buf), &value), -EBADMSG);
+}
+
+ZTEST(mdm_codec, test_ble_nus_round_trip)
+{
+	struct ble_nus_module_message msg = {
+		.type = BLE_RECV,
+		.len = 10,
+		.timestamp = 0x12345678,
+		.seq = 0xabcd,
+		.offset = 200,
+		.total_len = 210,
+		.conn_id = 2,
+	};
+	struct ble_nus_module_message out;
+	uint8_t buf[128];
+	int len;
+
+	memcpy(msg.data, "0123456789", msg.len);
+
+	len = ble_nus_link_codec.encode(&msg, buf, sizeof(buf), &ctx);
+	zassert_true(len > 0 && len < (int)sizeof(msg), "Unexpected length %d", len);
+
+	memset(&out, 0xa5, sizeof(out));
+	zassert_ok(ble_nus_link_codec.decode(buf, len, &out, &ctx));
+
+	zassert_equal(out.type, msg.type);
+	zassert_equal(out.len, msg.len);
+	zassert_equal(out.timestamp, msg.timestamp);
+	zassert_equal(out.seq, msg.seq);
+	zassert_equal(out.offset, msg.offset);
+	zassert_equal(out.total_len, msg.total_len);
+	zassert_equal(out.conn_id, msg.conn_id);
+	zassert_mem_equal(out.data, msg.data, sizeof(out.data));
+
+	/* A full message and an empty one */
+	msg.len = BLE_NUS_MODULE_MESSAGE_SIZE;
+	memset(msg.data, 'x', sizeof(msg.data));
+	len = ble_nus_link_codec.encode(&msg, buf, sizeof(buf), &ctx);
+	zassert_ok(ble_nus_link_codec.decode(buf, len, &out, &ctx));
+	zassert_equal(out.len, BLE_NUS_MODULE_MESSAGE_SIZE);
+	zassert_mem_equal(out.data, msg.data, sizeof(out.data));
+
+	msg.len = 0;
+	len = ble_nus_link_codec.encode(&msg, buf, sizeof(buf), &ctx);
+	zassert_ok(ble_nus_link_codec.decode(buf, len, &out, &ctx));
+	zassert_equal(out.len, 0);
+}
+
+ZTEST(mdm_codec, test_ble_nus_invalid)
+{
+	struct ble_nus_module_message msg = {
+		.len = 10,
+	};
+	struct ble_nus_module_message out = {
+		.len = 0x5a5a,
+	};
+	uint8_t buf[128];
+	int len;
+
+	len = ble_nus_link_codec.encode(&msg, buf, sizeof(buf), &ctx);
+	zassert_true(len > 0);
+
+	/* Too small for the encoded message */
+	zassert_equal(ble_nus_link_codec.encode(&msg, buf, len - 1, &ctx), -EMSGSIZE);
+
+	/* Truncated header and data, and a trailing byte */
+	zassert_equal(ble_nus_link_codec.decode(buf, 5, &out, &ctx), -EBADMSG);
+	zassert_equal(ble_nus_link_codec.decode(buf, len - 1, &out, &ctx), -EBADMSG);
+	zassert_equal(ble_nus_link_codec.decode(buf, len + 1, &out, &ctx), -EBADMSG);
+
+	/* Data length above the message buffer */
+	buf[12] = BLE_NUS_MODULE_MESSAGE_SIZE + 1;
+	zassert_equal(ble_nus_link_codec.decode(buf, sizeof(buf), &out, &ctx), -EBADMSG);
+
+	/* Invalid records leave the message alone */
+	zassert_equal(out.len, 0x5a5a);
+}
+
+ZTEST(mdm_codec, test_cs_distance_round_trip)
+{
+	struct cs_distance_msg msg = {
+		.type = CS_DISTANCE_MEASUREMENT,
+		.antenna_path = 3,
+		.ifft = 1.234f,
+		.phase_slope = NAN,
+		.rtt = -2.5f,
+		.timestamp = ctx.frame_time - 70,
+	};
+	struct cs_distance_msg out;
+	uint8_t buf[32];
+	int len;
+
+	len = cs_distance_link_codec.encode(&msg, buf, sizeof(buf), &ctx);
+	zassert_true(len > 0 && len < (int)sizeof(msg), "Unexpected length %d", len);
+
+	zassert_ok(cs_distance_link_codec.decode(buf, len, &out, &ctx));
+
+	zassert_equal(out.type, msg.type);
+	zassert_equal(out.antenna_path, msg.antenna_path);
+	zassert_equal(out.timestamp, msg.timestamp);
+	zassert_within(out.ifft, msg.ifft, 0.0005f);
+	zassert_true(isnan(out.phase_slope));
+	zassert_within(out.rtt, msg.rtt, 0.0005f);
+
+	/* Out of range distances saturate */
+	msg.ifft = 1e6f;
+	msg.rtt = -1e6f;
+	msg.timestamp = ctx.frame_time + 1000000;
+	len = cs_distance_link_codec.encode(&msg, buf, sizeof(buf), &ctx);
+	zassert_ok(cs_distance_link_codec.decode(buf, len, &out, &ctx));
+	zassert_within(out.ifft, 8388.607f, 0.0005f);
+	zassert_within(out.rtt, -8388.607f, 0.0005f);
+	zassert_equal(out.timestamp, msg.timestamp);
+
+	/* Infinite distances saturate as well, only NaN is sent as invalid */
+	msg.ifft = INFINITY;
+	msg.phase_slope = -INFINITY;
+	msg.rtt = NAN;
+	len = cs_distance_link_codec.encode(&msg, buf, sizeof(buf), &ctx);
+	zassert_ok(cs_distance_link_codec.decode(buf, len, &out, &ctx));
+	zassert_within(out.ifft, 8388.607f, 0.0005f);
+	zassert_within(out.phase_slope, -8388.607f, 0.0005f);
+	zassert_true(isnan(out.rtt));
+}
+
+ZTEST(mdm_codec, test_cs_distance_invalid)
+{
+	struct cs_distance_msg msg = {
+		.antenna_path = 1,
+		.ifft = 1.0f,
+		.phase_slope = 2.0f,
+		.rtt = 3.0f,
+		.timestamp = ctx.frame_time,
+	};
+	struct cs_distance_msg out = {
+		.antenna_path = 7,
+	};
+	uint8_t buf[32];
+	int len;
+
+	len = cs_distance_link_codec.encode(&msg, buf, sizeof(buf), &ctx);
+	zassert_true(len > 0);
+
+	zassert_equal(cs_distance_link_codec.encode(&msg, buf, len - 1, &ctx), -EMSGSIZE);
+
+	/* Empty record, missing distance bytes and trailing bytes */
+	zassert_true(cs_distance_link_codec.decode(buf, 0, &out, &ctx) < 0);
+	zassert_true(cs_distance_link_codec.decode(buf, len - 1, &out, &ctx) < 0);
+	zassert_true(cs_distance_link_codec.decode(buf, len + 1, &out, &ctx) < 0);
+
+	/* Unterminated timestamp */
+	memset(&buf[1], 0xff, sizeof(buf) - 1);
+	zassert_true(cs_distance_link_codec.decode(buf, sizeof(buf), &out, &ctx) < 0);
+
+	/* Antenna path beyond the flag bits */
+	msg.antenna_path = 8;
+	zassert_equal(cs_distance_link_codec.encode(&msg, buf, sizeof(buf), &ctx), -EINVAL);
+
+	zassert_equal(out.antenna_path, 7);
+}
+
+ZTEST_SUITE(mdm_codec, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "mdm_link.h"
+#include "mdm_link_transport.h"
+
+/* The loopback answers this image's own frames. Every transmitted channel is received back on a
+ * mirrored channel, and the credit and acknowledgment reports of the mirrored channel return to
+ * the transmitted one.
+ */
+struct test_msg {
+	uint32_t seq;
+	uint8_t data[12];
+};
+
+/* Record identifiers after those of the modules, none of which are built */
+enum test_id {
+	TEST_ID_DATA = 0x70,
+	TEST_ID_DATA_RX,
+	TEST_ID_RELIABLE,
+	TEST_ID_RELIABLE_RX,
+	TEST_ID_INJECT,
+};
+
+#define TEST_RX_TIMEOUT K_SECONDS(2)
+
+/* Long enough for a window reset after the reports of a whole window were lost */
+#define TEST_CREDIT_TIMEOUT K_MSEC(2 * CONFIG_MDM_LINK_CREDIT_TIMEOUT_MS + 1000)
+
+BUILD_ASSERT(MDM_LINK_RETX_FITS(struct test_msg));
+
+K_MSGQ_DEFINE(rx_msgq, sizeof(struct test_msg), 16, 4);
+K_MSGQ_DEFINE(reliable_msgq, sizeof(struct test_msg), 16, 4);
+K_MSGQ_DEFINE(inject_msgq, sizeof(struct test_msg), 16, 4);
+
+/* Queues every received message in the queue given as the channel's user data */
+static void rx_callback(const struct zbus_channel *chan)
+{
+	(void)k_msgq_put(zbus_chan_user_data(chan), zbus_chan_const_msg(chan), K_NO_WAIT);
+}
+
+ZBUS_LISTENER_DEFINE(test_rx, rx_callback);
+
+ZBUS_CHAN_DEFINE(TEST_CHAN, struct test_msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+MDM_PROXY_ADD_CHAN(MDM_LINK_IPC_NODE, TEST_CHAN, TEST_ID_DATA);
+MDM_SHADOW_CHAN_DEFINE(TEST_RX_CHAN, struct test_msg, MDM_LINK_IPC_NODE, TEST_ID_DATA_RX,
+		       &rx_msgq, ZBUS_OBSERVERS(test_rx), ZBUS_MSG_INIT(0));
+MDM_LINK_LOOPBACK_MIRROR(test_data, TEST_ID_DATA, TEST_ID_DATA_RX);
+
+ZBUS_CHAN_DEFINE(TEST_RELIABLE_CHAN, struct test_msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+MDM_PROXY_ADD_CHAN_WITH_FLAGS(MDM_LINK_IPC_NODE, TEST_RELIABLE_CHAN, TEST_ID_RELIABLE, NULL,
+			      MDM_LINK_LANE_DEFAULT, MDM_LINK_CHAN_RELIABLE);
+MDM_SHADOW_CHAN_DEFINE(TEST_RELIABLE_RX_CHAN, struct test_msg, MDM_LINK_IPC_NODE,
+		       TEST_ID_RELIABLE_RX, &reliable_msgq, ZBUS_OBSERVERS(test_rx),
+		       ZBUS_MSG_INIT(0));
+MDM_LINK_LOOPBACK_MIRROR(test_reliable, TEST_ID_RELIABLE, TEST_ID_RELIABLE_RX);
+
+/* Only receives the frames handed to mdm_link_receive() by the tests */
+MDM_SHADOW_CHAN_DEFINE(TEST_INJECT_CHAN, struct test_msg, MDM_LINK_IPC_NODE, TEST_ID_INJECT,
+		       &inject_msgq, ZBUS_OBSERVERS(test_rx), ZBUS_MSG_INIT(0));
+
+static void publish(const struct zbus_channel *chan, uint32_t seq)
+{
+	struct test_msg msg = {
+		.seq = seq,
+	};
+
+	memset(msg.data, (uint8_t)seq, sizeof(msg.data));
+
+	zassert_ok(zbus_chan_pub(chan, &msg, K_MSEC(100)), "Cannot publish %u", seq);
+}
+
+static void receive(struct k_msgq *msgq, uint32_t seq)
+{
+	struct test_msg msg;
+
+	zassert_ok(k_msgq_get(msgq, &msg, TEST_RX_TIMEOUT), "Record %u not received", seq);
+	zassert_equal(msg.seq, seq);
+	zassert_equal(msg.data[0], (uint8_t)seq);
+	zassert_equal(msg.data[sizeof(msg.data) - 1], (uint8_t)seq);
+}
+
+/* Wait until the channel has credits for count records */
+static int tx_ready_wait(const struct zbus_channel *chan, uint16_t count, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	while (mdm_link_tx_ready_count(chan, count)) {
+		if (sys_timepoint_expired(end)) {
+			return -EAGAIN;
+		}
+
+		k_sleep(K_MSEC(1));
+	}
+
+	return 0;
+}
+
+/* Hand a frame holding the given records to the link as if the other domain had sent it */
+static void inject(const uint8_t *records, size_t len)
+{
+	uint8_t buf[sizeof(struct mdm_link_frame_hdr) + 64];
+	struct mdm_link_frame_hdr hdr = {
+		.time = k_uptime_get_32(),
+		.len = len,
+	};
+
+	zassert_true(len <= sizeof(buf) - sizeof(hdr));
+
+	memcpy(buf, &hdr, sizeof(hdr));
+	memcpy(&buf[sizeof(hdr)], records, len);
+
+	mdm_link_receive(&mdm_link_ipc, buf, sizeof(hdr) + len);
+}
+
+ZTEST(mdm_link, test_round_trip)
+{
+	Z_TEST_SKIP_IFDEF(CONFIG_MDM_LINK_FAULT_INJECTION);
+
+	for (uint32_t seq = 0; seq < 3; seq++) {
+		zassert_ok(tx_ready_wait(&TEST_CHAN, 1, TEST_CREDIT_TIMEOUT));
+		publish(&TEST_CHAN, seq);
+		receive(&rx_msgq, seq);
+	}
+
+	/* Sent without waiting for the batching window */
+	zassert_ok(tx_ready_wait(&TEST_CHAN, 1, TEST_CREDIT_TIMEOUT));
+	publish(&TEST_CHAN, 3);
+	zassert_ok(mdm_link_flush());
+	receive(&rx_msgq, 3);
+}
+
+ZTEST(mdm_link, test_garbage_frames)
+{
+	struct mdm_link_chan_stats before;
+	struct mdm_link_chan_stats after;
+	struct test_msg msg = {
+		.seq = 0x1234,
+	};
+	uint8_t records[2 + sizeof(msg)];
+	uint8_t buf[sizeof(struct mdm_link_frame_hdr) + 4] = { 0 };
+	struct mdm_link_frame_hdr hdr = {
+		.len = 40,
+	};
+
+	Z_TEST_SKIP_IFDEF(CONFIG_MDM_LINK_FAULT_INJECTION);
+
+	zassert_ok(mdm_link_chan_stats_get(&TEST_INJECT_CHAN, &before));
+
+	/* Shorter than a frame header, and a header claiming more than was received */
+	mdm_link_receive(&mdm_link_ipc, buf, 3);
+	memcpy(buf, &hdr, sizeof(hdr));
+	mdm_link_receive(&mdm_link_ipc, buf, sizeof(buf));
+
+	/* Record running past the end of the frame */
+	inject((const uint8_t[]){ TEST_ID_INJECT, sizeof(msg), 1, 2, 3, 4 }, 6);
+
+	/* Unknown record identifier */
+	inject((const uint8_t[]){ 0x7e, 2, 1, 2 }, 4);
+
+	/* Record of the wrong size, counted as an error */
+	inject((const uint8_t[]){ TEST_ID_INJECT, 4, 1, 2, 3, 4 }, 6);
+
+	/* Sequenced record without a sequence number, on a channel that is not reliable */
+	inject((const uint8_t[]){ TEST_ID_INJECT | MDM_LINK_ID_SEQ, 0 }, 2);
+
+	/* Empty, unknown and truncated control records */
+	inject((const uint8_t[]){ MDM_LINK_ID_CONTROL, 0 }, 2);
+	inject((const uint8_t[]){ MDM_LINK_ID_CONTROL, 1, 0x7f }, 3);
+	inject((const uint8_t[]){ MDM_LINK_ID_CONTROL, 2, MDM_LINK_CTRL_CREDIT, TEST_ID_DATA }, 4);
+	inject((const uint8_t[]){ MDM_LINK_ID_CONTROL, 3, MDM_LINK_CTRL_HELLO,
+				  MDM_LINK_HELLO_REQ, 0 }, 5);
+	inject((const uint8_t[]){ MDM_LINK_ID_CONTROL, 2, MDM_LINK_CTRL_SEQ_ACK,
+				  TEST_ID_RELIABLE }, 4);
+
+	zassert_equal(k_msgq_num_used_get(&inject_msgq), 0, "Invalid record published");
+	zassert_true(mdm_link_chan_synced(&TEST_CHAN) || !IS_ENABLED(CONFIG_MDM_LINK_RESYNC),
+		     "Truncated handshake record restarted the link");
+
+	zassert_ok(mdm_link_chan_stats_get(&TEST_INJECT_CHAN, &after));
+	zassert_equal(after.records, before.records + 1);
+	zassert_equal(after.errors, before.errors + 1);
+
+	/* The link still takes valid records */
+	records[0] = TEST_ID_INJECT;
+	records[1] = sizeof(msg);
+	memcpy(&records[2], &msg, sizeof(msg));
+	inject(records, sizeof(records));
+
+	zassert_ok(k_msgq_get(&inject_msgq, &msg, K_NO_WAIT));
+	zassert_equal(msg.seq, 0x1234);
+}
+
+ZTEST(mdm_link, test_credit_window)
+{
+	struct mdm_link_flow_stats before;
+	struct mdm_link_flow_stats after;
+	uint32_t sent = 0;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MDM_LINK_FLOW_CONTROL);
+	Z_TEST_SKIP_IFDEF(CONFIG_MDM_LINK_FAULT_INJECTION);
+
+	zassert_equal(mdm_link_tx_ready_count(&TEST_CHAN, CONFIG_MDM_LINK_CREDITS + 1), -EMSGSIZE);
+
+	/* Receivers report every half window, so up to half a window may still be in flight */
+	zassert_ok(tx_ready_wait(&TEST_CHAN, CONFIG_MDM_LINK_CREDITS / 2 + 1,
+				 TEST_CREDIT_TIMEOUT));
+	zassert_ok(mdm_link_flow_stats_get(&mdm_link_ipc, &before));
+
+	/* Nothing is sent or received before this thread sleeps */
+	while (mdm_link_tx_ready(&TEST_CHAN) == 0) {
+		zassert_true(sent < CONFIG_MDM_LINK_CREDITS, "Credits not taken");
+		publish(&TEST_CHAN, sent++);
+	}
+
+	zassert_true(sent > CONFIG_MDM_LINK_CREDITS / 2);
+
+	/* The first update waits for credits, the second replaces it */
+	publish(&TEST_CHAN, sent);
+	publish(&TEST_CHAN, sent + 1);
+
+	for (uint32_t seq = 0; seq < sent; seq++) {
+		receive(&rx_msgq, seq);
+	}
+
+	receive(&rx_msgq, sent + 1);
+	zassert_equal(k_msgq_get(&rx_msgq, &(struct test_msg){ 0 }, K_MSEC(100)), -EAGAIN,
+		      "Replaced update sent");
+
+	zassert_ok(mdm_link_flow_stats_get(&mdm_link_ipc, &after));
+	zassert_true(after.throttled > before.throttled);
+	zassert_equal(after.dropped, before.dropped + 1);
+	zassert_equal(after.resyncs, before.resyncs, "Credits not returned by the reports");
+}
+
+ZTEST(mdm_link, test_credit_recovery)
+{
+	struct test_msg msg;
+	uint32_t next = 0;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MDM_LINK_FLOW_CONTROL);
+
+	/* With lost frames, lost records and reports are only made up for by the window reset */
+	for (uint32_t seq = 0; seq < 50; seq++) {
+		zassert_ok(tx_ready_wait(&TEST_CHAN, 1, TEST_CREDIT_TIMEOUT),
+			   "Channel stuck without credits at %u", seq);
+		publish(&TEST_CHAN, seq);
+
+		while (k_msgq_get(&rx_msgq, &msg, K_NO_WAIT) == 0) {
+			zassert_true(msg.seq >= next, "Record %u received after %u", msg.seq,
+				     next - 1);
+			next = msg.seq + 1;
+		}
+	}
+
+	zassert_ok(tx_ready_wait(&TEST_CHAN, CONFIG_MDM_LINK_CREDITS / 2 + 1,
+				 TEST_CREDIT_TIMEOUT));
+}
+
+ZTEST(mdm_link, test_reliable_in_order)
+{
+	struct mdm_link_retx_stats before;
+	struct mdm_link_retx_stats after;
+	struct test_msg msg;
+	uint32_t next = 0;
+	const uint32_t count = 50;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MDM_LINK_RELIABLE);
+
+	zassert_ok(mdm_link_retx_stats_get(&mdm_link_ipc, &before));
+
+	/* The credit window is smaller than the retransmit window, so nothing is given up and every
+	 * record arrives once and in order
+	 */
+	for (uint32_t seq = 0; seq < count; seq++) {
+		zassert_ok(tx_ready_wait(&TEST_RELIABLE_CHAN, 1, TEST_CREDIT_TIMEOUT),
+			   "Channel stuck without credits at %u", seq);
+		publish(&TEST_RELIABLE_CHAN, seq);
+
+		while (k_msgq_get(&reliable_msgq, &msg, K_NO_WAIT) == 0) {
+			zassert_equal(msg.seq, next, "Record %u received instead of %u", msg.seq,
+				      next);
+			next++;
+		}
+	}
+
+	while (next < count) {
+		receive(&reliable_msgq, next++);
+	}
+
+	zassert_ok(mdm_link_retx_stats_get(&mdm_link_ipc, &after));
+	zassert_equal(after.abandoned, before.abandoned);
+
+	if (IS_ENABLED(CONFIG_MDM_LINK_FAULT_INJECTION)) {
+		zassert_true(after.retransmits > before.retransmits, "Lost records not sent again");
+	}
+}
+
+ZTEST(mdm_link, test_resync)
+{
+	struct mdm_link_sync_msg sync;
+	struct test_msg msg;
+	uint8_t hello[2 + 6] = { MDM_LINK_ID_CONTROL, 6, MDM_LINK_CTRL_HELLO, MDM_LINK_HELLO_REQ };
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MDM_LINK_RESYNC);
+	Z_TEST_SKIP_IFDEF(CONFIG_MDM_LINK_FAULT_INJECTION);
+
+	zassert_true(mdm_link_chan_synced(&TEST_CHAN), "Link-up handshake not completed");
+	zassert_ok(zbus_chan_read(&MDM_LINK_SYNC_CHAN, &sync, K_NO_WAIT));
+	zassert_equal_ptr(sync.link, &mdm_link_ipc);
+
+	zassert_ok(tx_ready_wait(&TEST_CHAN, 1, TEST_CREDIT_TIMEOUT));
+	publish(&TEST_CHAN, 100);
+	receive(&rx_msgq, 100);
+
+	/* A handshake request with a new nonce, as sent by the other domain after a restart */
+	sys_put_le32(mdm_link_ipc.peer_nonce + 1, &hello[4]);
+	inject(hello, sizeof(hello));
+
+	zassert_false(mdm_link_chan_synced(&TEST_CHAN));
+
+	/* The latest message is replayed, once for each half of the handshake */
+	receive(&rx_msgq, 100);
+
+	for (int i = 0; i < 100 && !mdm_link_chan_synced(&TEST_CHAN); i++) {
+		k_sleep(K_MSEC(10));
+	}
+
+	zassert_true(mdm_link_chan_synced(&TEST_CHAN), "Handshake not completed");
+
+	/* Credit windows restarted on both ends */
+	zassert_ok(tx_ready_wait(&TEST_CHAN, CONFIG_MDM_LINK_CREDITS / 2 + 1, K_SECONDS(1)));
+
+	while (k_msgq_get(&rx_msgq, &msg, K_MSEC(100)) == 0) {
+		zassert_equal(msg.seq, 100);
+	}
+}
+
+static void *mdm_link_setup(void)
+{
+	/* The link-up handshake replays nothing, since nothing was published yet */
+	for (int i = 0; i < 500 && !mdm_link_chan_synced(&TEST_CHAN); i++) {
+		k_sleep(K_MSEC(10));
+	}
+
+	return NULL;
+}
+
+static void mdm_link_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_msgq_purge(&rx_msgq);
+	k_msgq_purge(&reliable_msgq);
+	k_msgq_purge(&inject_msgq);
+}
+
+ZTEST_SUITE(mdm_link, NULL, mdm_link_setup, mdm_link_before, NULL, NULL);